@@ -5,8 +5,11 @@ set(JT_ENABLE_WEB OFF CACHE BOOL "enable web build using SDL and em++")
 set(JT_ENABLE_AUDIO_TESTS OFF CACHE BOOL "enable unittests that require a display")
 set(JT_ENABLE_CLANG_TIDY OFF CACHE BOOL "enable clang tidy checks")
 set(JT_ENABLE_DEBUG ON CACHE BOOL "enable debug options")
+set(JT_ENABLE_STRING_ID_CHECKS OFF CACHE BOOL "check hashed ids for collisions (slow)")
 set(JT_ENABLE_TRACY ON CACHE BOOL "enable tracy options")
 set(JT_ENABLE_LTO_OPTIMIZATION OFF CACHE BOOL "enable final optimization (LTO)")
+set(JT_ENABLE_ASSET_PACK OFF CACHE BOOL
+        "pack all assets into a single file (not used for web builds)")
 
 # if JT_ENABLE_WEB is ON, it is required to use SDL
 if (JT_ENABLE_WEB)
@@ -20,6 +23,10 @@ if (JT_ENABLE_DEBUG)
     add_definitions(-DJT_ENABLE_DEBUG)
 endif ()
 
+if (JT_ENABLE_STRING_ID_CHECKS)
+    add_definitions(-DJT_ENABLE_STRING_ID_CHECKS)
+endif ()
+
 if (JT_ENABLE_TRACY)
     add_definitions(-DTRACY_ENABLE)
 endif ()
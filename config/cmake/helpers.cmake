@@ -11,6 +11,14 @@ function(jt_use_assets TGT)
                 COMMAND ${CMAKE_COMMAND} -E copy_directory
                 ${CMAKE_SOURCE_DIR}/assets ${CMAKE_CURRENT_BINARY_DIR}/Release/assets)
     endif ()
+
+    # the game loads files from the pack if it exists next to the executable
+    if (JT_ENABLE_ASSET_PACK AND NOT JT_ENABLE_WEB)
+        add_dependencies(${TGT} AssetPacker)
+        add_custom_command(TARGET ${TGT} POST_BUILD
+                COMMAND AssetPacker $<TARGET_FILE_DIR:${TGT}>/assets.jtpack assets
+                WORKING_DIRECTORY ${CMAKE_SOURCE_DIR})
+    endif ()
 endfunction()
 
 function(target_link_libraries_system target)
@@ -1,6 +1,7 @@
 ﻿#include "main.hpp"
 #include <action_commands/action_command_manager.hpp>
 #include <action_commands/basic_action_commands.hpp>
+#include <asset_pack/virtual_file_system.hpp>
 #include <audio/audio/audio_impl.hpp>
 #include <audio/audio/audio_null.hpp>
 #include <cache/cache_impl.hpp>
@@ -23,6 +24,8 @@
 #include <state_manager/logging_state_manager.hpp>
 #include <state_manager/state_manager.hpp>
 #include <state_start_with_button.hpp>
+#include <system_helper.hpp>
+#include <filesystem>
 #include <memory>
 
 std::shared_ptr<jt::GameBase> game;
@@ -34,12 +37,20 @@ void gameloop()
     }
 }
 
-int main(int /*argc*/, char* /*argv*/[])
+int main(int /*argc*/, char* argv[])
 {
     hideConsoleInRelease();
 
     jt::Random::useTimeAsRandomSeed();
 
+    // the pack is only created by the AssetPacker, otherwise assets are loaded from disk. It is
+    // written next to the executable, which is not necessarily the working directory.
+    auto const packFileName
+        = (std::filesystem::path { argv[0] }.parent_path() / "assets.jtpack").string();
+    if (jt::SystemHelper::checkForValidFile(packFileName)) {
+        jt::VirtualFileSystem::mount(packFileName);
+    }
+
     auto logHistory = std::make_shared<jt::LogHistory>();
     jt::CacheImpl cache { nullptr, logHistory };
 
@@ -55,6 +66,7 @@ int main(int /*argc*/, char* /*argv*/[])
     jt::LoggingCamera loggingCamera { cam, logger };
 
     jt::GfxImpl gfx { loggingRenderWindow, loggingCamera };
+    gfx.textureManager().setMemoryBudget(GP::TextureMemoryBudget());
 
     auto const mouse = std::make_shared<jt::MouseInput>();
     auto const keyboard = std::make_shared<jt::KeyboardInput>();
@@ -4,6 +4,7 @@
 #include <color/color.hpp>
 #include <color/palette.hpp>
 #include <vector.hpp>
+#include <cstddef>
 #include <string>
 
 class GP {
@@ -27,6 +28,10 @@ public:
 
     static float GetZoom() { return 4.0f; }
 
+    static int ZLayerHud() { return 1; }
+
+    static std::size_t TextureMemoryBudget() { return 64u * 1024u * 1024u; }
+
     static jt::Vector2f GetScreenSize() { return GetWindowSize() * (1.0f / GetZoom()); }
 
     static jt::Color PaletteBackground() { return GP::getPalette().getColor(4); }
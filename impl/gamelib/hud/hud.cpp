@@ -11,18 +11,28 @@ std::shared_ptr<ObserverInterface<int>> Hud::getObserverScoreP2() const { return
 
 void Hud::doCreate()
 {
+    // the hud only changes when a score changes, so its z layer is kept across frames
+    getGame()->gfx().createZLayer(GP::ZLayerHud());
+    renderTarget()->setLayerCached(GP::ZLayerHud(), true);
+    renderTarget()->setLayerIgnoresCamMovement(GP::ZLayerHud(), true);
+
     m_scoreP1Text = std::make_shared<jt::Text>();
-    m_scoreP1Text = jt::dh::createText(renderTarget(), "", 16, jt::Color { 248, 249, 254 });
+    auto& fontCache = getGame()->cache().getFontCache();
+    m_scoreP1Text
+        = jt::dh::createText(renderTarget(), fontCache, "", 16, jt::Color { 248, 249, 254 });
     m_scoreP1Text->setTextAlign(jt::Text::TextAlign::LEFT);
     m_scoreP1Text->setIgnoreCamMovement(true);
     m_scoreP1Text->setPosition({ 10, 4 });
+    m_scoreP1Text->setZ(GP::ZLayerHud());
 
     m_scoreP1Display = std::make_shared<ScoreDisplay>(m_scoreP1Text, "P1 Score: ");
 
-    m_scoreP2Text = jt::dh::createText(renderTarget(), "", 16, jt::Color { 248, 249, 254 });
+    m_scoreP2Text
+        = jt::dh::createText(renderTarget(), fontCache, "", 16, jt::Color { 248, 249, 254 });
     m_scoreP2Text->setTextAlign(jt::Text::TextAlign::RIGHT);
     m_scoreP2Text->setIgnoreCamMovement(true);
     m_scoreP2Text->setPosition({ GP::GetScreenSize().x - 10, 4 });
+    m_scoreP2Text->setZ(GP::ZLayerHud());
 
     m_scoreP2Display = std::make_shared<ScoreDisplay>(m_scoreP2Text, "P2 Score: ");
 }
@@ -23,6 +23,19 @@ void Killbox::doCreate()
             "assets/test/integration/demo/V3_complete_Tileset_8x8.png", jt::Recti { 120, 40, 8, 8 },
             textureManager());
     }
+    updatePartPositions();
+}
+
+void Killbox::updatePartPositions()
+{
+    m_partPositions.clear();
+    if (!m_drawable) {
+        return;
+    }
+    auto const numberOfParts = static_cast<int>(m_rect.width) / 8;
+    for (int i = 0; i != numberOfParts; ++i) {
+        m_partPositions.push_back(jt::Vector2f { m_rect.left + i * 8.0f, m_rect.top + 0.0f });
+    }
 }
 
 void Killbox::doUpdate(float const elapsed)
@@ -35,15 +48,7 @@ void Killbox::doUpdate(float const elapsed)
 void Killbox::doDraw() const
 {
     if (m_drawable) {
-        if (m_type == "spike_down" || m_type == "spike_up") {
-            auto numberOfParts = static_cast<int>(m_rect.width) / 8;
-            for (int i = 0; i != numberOfParts; ++i) {
-                m_drawable->setPosition(jt::Vector2f { m_rect.left + i * 8.0f, m_rect.top + 0.0f });
-                m_drawable->update(0.0f);
-                m_drawable->draw(renderTarget());
-            }
-            //            m_drawable->draw(renderTarget());
-        }
+        m_drawable->drawInstances(renderTarget(), m_partPositions);
     }
 }
 
@@ -65,4 +70,5 @@ void Killbox::setPosition(jt::Vector2f const& pos)
 {
     m_rect.left = pos.x;
     m_rect.top = pos.y;
+    updatePartPositions();
 }
@@ -1,11 +1,13 @@
 #ifndef JAMTEMPLATE_KILLBOX_HPP
 #define JAMTEMPLATE_KILLBOX_HPP
 
-#include "graphics/drawable_interface.hpp"
 #include <game_object.hpp>
 #include <rect.hpp>
+#include <sprite.hpp>
 #include <vector.hpp>
 #include <functional>
+#include <memory>
+#include <vector>
 
 // TODO think about interface
 class Killbox : public jt::GameObject {
@@ -20,13 +22,15 @@ public:
     void setPosition(jt::Vector2f const& pos);
 
 private:
-    mutable std::shared_ptr<jt::DrawableInterface> m_drawable { nullptr };
+    mutable std::shared_ptr<jt::Sprite> m_drawable { nullptr };
+    std::vector<jt::Vector2f> m_partPositions {};
     jt::Rectf m_rect {};
 
     std::string m_name { "" };
     std::string m_type { "" };
 
     void doCreate() override;
+    void updatePartPositions();
     void doUpdate(float const elapsed) override;
     void doDraw() const override;
 };
@@ -42,12 +42,12 @@ void MovingPlatform::doCreate()
     m_physicsObject->setPosition(p1);
     //    m_physicsObject->setVelocity(m_currentVelocity);
 
-    m_spriteL = std::make_shared<jt::Sprite>(
-        "assets/test/integration/demo/platform_l.png", textureManager());
-    m_spriteM = std::make_shared<jt::Sprite>(
-        "assets/test/integration/demo/platform_m.png", textureManager());
-    m_spriteR = std::make_shared<jt::Sprite>(
-        "assets/test/integration/demo/platform_r.png", textureManager());
+    m_sprite = std::make_shared<jt::StripSprite>("assets/test/integration/demo/platform_l.png",
+        "assets/test/integration/demo/platform_m.png",
+        "assets/test/integration/demo/platform_r.png",
+        jt::Vector2u { static_cast<unsigned int>(m_platformSize.x),
+            static_cast<unsigned int>(m_platformSize.y) },
+        true, textureManager());
 }
 
 bool MovingPlatform::moveFromTo(
@@ -75,6 +75,9 @@ bool MovingPlatform::moveFromTo(
 
 void MovingPlatform::doUpdate(float const elapsed)
 {
+    m_sprite->setPosition(m_physicsObject->getPosition());
+    m_sprite->update(elapsed);
+
     m_timeOffset -= elapsed;
     if (m_timeOffset > 0) {
         return;
@@ -122,25 +125,9 @@ void MovingPlatform::doUpdate(float const elapsed)
 
 void MovingPlatform::doDraw() const
 {
-    auto numberOfMiddlePartsY = static_cast<int>(m_platformSize.y) / 8;
-    for (int j = 0; j != numberOfMiddlePartsY; ++j) {
-        m_spriteL->setPosition(m_physicsObject->getPosition() + jt::Vector2f { 0.0f, j * 8.0f });
-        m_spriteL->update(0.0f);
-        m_spriteL->draw(renderTarget());
-
-        auto numberOfMiddlePartsX = static_cast<int>(m_platformSize.x) / 8 - 2;
-
-        for (int i = 0; i != numberOfMiddlePartsX; ++i) {
-            m_spriteM->setPosition(
-                m_physicsObject->getPosition() + jt::Vector2f { (i + 1) * 8.0f, j * 8.0f });
-            m_spriteM->update(0.0f);
-            m_spriteM->draw(renderTarget());
-        }
-        m_spriteR->setPosition(
-            m_physicsObject->getPosition() + jt::Vector2f { m_platformSize.x - 8, j * 8.0f });
-        m_spriteR->update(0.0f);
-        m_spriteR->draw(renderTarget());
-    }
+    // the physics step may have moved the platform since doUpdate()
+    m_sprite->setPosition(m_physicsObject->getPosition());
+    m_sprite->draw(renderTarget());
 }
 
 void MovingPlatform::setLinkedKillbox(std::shared_ptr<Killbox> kb)
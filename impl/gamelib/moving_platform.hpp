@@ -1,11 +1,10 @@
 #ifndef JAMTEMPLATE_MOVING_PLATFORM_HPP
 #define JAMTEMPLATE_MOVING_PLATFORM_HPP
 
-#include "sprite.hpp"
 #include <killbox.hpp>
 #include <box2dwrapper/box2d_object.hpp>
 #include <game_object.hpp>
-#include <shape.hpp>
+#include <strip_sprite.hpp>
 #include <memory>
 
 class MovingPlatform : public jt::GameObject {
@@ -22,9 +21,7 @@ private:
     float m_velocity { 1.0f };
     float m_timeOffset { 0.0f };
     jt::Vector2f m_platformSize { 0.0f, 0.0f };
-    mutable std::shared_ptr<jt::Sprite> m_spriteL { nullptr };
-    mutable std::shared_ptr<jt::Sprite> m_spriteM { nullptr };
-    mutable std::shared_ptr<jt::Sprite> m_spriteR { nullptr };
+    std::shared_ptr<jt::StripSprite> m_sprite { nullptr };
 
     bool m_movingForward { true };
     std::size_t m_currentIndex { 0 };
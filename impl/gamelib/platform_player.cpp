@@ -17,8 +17,10 @@ Player::Player(std::shared_ptr<jt::Box2DWorldInterface> world)
 void Player::doCreate()
 {
     m_animation = std::make_shared<jt::Animation>();
-    m_animation->loadFromAseprite(
-        m_playerId == 0 ? "assets/player.aseprite" : "assets/Player2.aseprite", textureManager());
+    // the registry keeps the animation data when the state is left, so it is not parsed again
+    auto const fileName = m_playerId == 0 ? "assets/player.aseprite" : "assets/Player2.aseprite";
+    m_animation->setData(
+        getGame()->cache().getAssetRegistry().get<jt::AnimationData>(fileName), textureManager());
     m_animation->play("idle");
     m_animation->setOrigin({ 2, 4 });
 
@@ -332,12 +334,12 @@ jt::Vector2f Player::getPosition() const { return m_physicsObject->getPosition()
 
 jt::Vector2f Player::getGravityDirection() const { return m_gravityDirection; }
 
-void Player::setWalkParticleSystem(std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> ps)
+void Player::setWalkParticleSystem(std::weak_ptr<jt::ParticleBatch<50>> ps)
 {
     m_walkParticles = ps;
 }
 
-void Player::setJumpParticleSystem(std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> ps)
+void Player::setJumpParticleSystem(std::weak_ptr<jt::ParticleBatch<50>> ps)
 {
     m_postJumpParticles = ps;
 }
@@ -5,7 +5,7 @@
 #include <animation.hpp>
 #include <box2dwrapper/box2d_object.hpp>
 #include <game_object.hpp>
-#include <particle_system.hpp>
+#include <particle_batch.hpp>
 #include <shape.hpp>
 #include <Box2D/Box2D.h>
 #include <memory>
@@ -37,8 +37,8 @@ public:
     jt::Vector2f getPosition() const;
     jt::Vector2f getGravityDirection() const;
 
-    void setWalkParticleSystem(std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> ps);
-    void setJumpParticleSystem(std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> ps);
+    void setWalkParticleSystem(std::weak_ptr<jt::ParticleBatch<50>> ps);
+    void setJumpParticleSystem(std::weak_ptr<jt::ParticleBatch<50>> ps);
 
     void setLevelSize(jt::Vector2f const& levelSizeInTiles);
     void setPlayerId(int playerId);
@@ -51,8 +51,8 @@ private:
     std::shared_ptr<jt::Animation> m_animation;
     std::shared_ptr<jt::Box2DObject> m_physicsObject;
     float m_walkParticlesTimer = 0.0f;
-    std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> m_walkParticles;
-    std::weak_ptr<jt::ParticleSystem<jt::Shape, 50>> m_postJumpParticles;
+    std::weak_ptr<jt::ParticleBatch<50>> m_walkParticles;
+    std::weak_ptr<jt::ParticleBatch<50>> m_postJumpParticles;
 
     bool m_isTouchingGround { false };
     bool m_wasTouchingGroundLastFrame { false };
@@ -11,8 +11,6 @@
 #include <random/random.hpp>
 #include <state_menu.hpp>
 #include <tweens/tween_alpha.hpp>
-#include <tweens/tween_position.hpp>
-#include <tweens/tween_rotation.hpp>
 
 StatePlatformer::StatePlatformer(std::string const& levelName) { m_levelName = levelName; }
 
@@ -229,44 +227,25 @@ void StatePlatformer::CreatePlayer()
 
 void StatePlatformer::createPlayerJumpParticleSystem()
 {
-    m_playerJumpParticles = jt::ParticleSystem<jt::Shape, 50>::createPS(
-        [this]() {
-            auto s = std::make_shared<jt::Shape>();
-            if (jt::Random::getChance()) {
-                s->makeRect(jt::Vector2f { 1.0f, 1.0f }, textureManager());
-            } else {
-                s->makeRect(jt::Vector2f { 2.0f, 2.0f }, textureManager());
-            }
-            s->setColor(jt::colors::White);
-            s->setPosition(jt::Vector2f { -50000, -50000 });
-            s->setOrigin(jt::Vector2f { 1.0f, 1.0f });
-            return s;
-        },
-        [this](auto s, auto p) {
-            s->setPosition(p);
-            s->update(0.0f);
-            auto const totalTime = jt::Random::getFloat(0.2f, 0.3f);
-
-            auto twa = jt::TweenAlpha::create(s, totalTime / 2.0f, 255, 0);
-            twa->setStartDelay(totalTime / 2.0f);
-            add(twa);
-
-            auto const startPos = p;
-            auto const endPos = p
-                + jt::Vector2f { jt::Random::getFloatGauss(0, 4.5f),
-                      jt::Random::getFloat(-2.0f, 0.0f) };
-            auto twp = jt::TweenPosition::create(s, totalTime, startPos, endPos);
-            add(twp);
-
-            float minAngle = 0.0f;
-            float maxAngle = 360.0f;
-            if (endPos.x < startPos.x) {
-                minAngle = 360.0f;
-                maxAngle = 0.0f;
-            }
-            auto twr = jt::TweenRotation::create(s, totalTime, minAngle, maxAngle);
-            add(twr);
-        });
+    auto shape = std::make_shared<jt::Shape>();
+    shape->makeRect(jt::Vector2f { 1.0f, 1.0f }, textureManager());
+    shape->setOrigin(jt::Vector2f { 0.5f, 0.5f });
+
+    m_playerJumpParticles
+        = jt::ParticleBatch<50>::createPB(shape, [](jt::Particle& p, jt::Vector2f const& /*pos*/) {
+              auto const size = jt::Random::getChance() ? 1.0f : 2.0f;
+              p.scale = jt::Vector2f { size, size };
+              p.lifetime = jt::Random::getFloat(0.2f, 0.3f);
+
+              auto const distance = jt::Vector2f { jt::Random::getFloatGauss(0, 4.5f),
+                  jt::Random::getFloat(-2.0f, 0.0f) };
+              p.velocity = distance / p.lifetime;
+
+              // one full turn over the lifetime, in the direction of movement
+              p.angularVelocity = (distance.x < 0.0f ? -360.0f : 360.0f) / p.lifetime;
+          });
+    // particles are opaque for the first half of their lifetime and fade out afterwards
+    m_playerJumpParticles->setAlphaCurve({ { 0.0f, 1.0f }, { 0.5f, 1.0f }, { 1.0f, 0.0f } });
     add(m_playerJumpParticles);
     m_player0->setJumpParticleSystem(m_playerJumpParticles);
     m_player1->setJumpParticleSystem(m_playerJumpParticles);
@@ -274,43 +253,25 @@ void StatePlatformer::createPlayerJumpParticleSystem()
 
 void StatePlatformer::createPlayerWalkParticles()
 {
-    m_walkParticles = jt::ParticleSystem<jt::Shape, 50>::createPS(
-        [this]() {
-            auto s = std::make_shared<jt::Shape>();
-            s->makeRect(jt::Vector2f { 1.0f, 1.0f }, textureManager());
-            s->setColor(jt::colors::Black);
-            s->setPosition(jt::Vector2f { -50000, -50000 });
-            return s;
-        },
-        [this](auto s, auto p) {
-            s->setPosition(p);
-
-            auto twa = jt::TweenAlpha::create(s, 1.5f, 255, 0);
-            add(twa);
-
-            auto const rp
-                = p + jt::Vector2f { 0, 4 } + jt::Vector2f { jt::Random::getFloat(-4, 4), 0 };
-
-            auto topPos = rp;
-            auto botPos = rp;
-            auto const maxHeight = jt::Random::getFloat(2.0f, 7.0f);
-            auto const maxWidth = jt::Random::getFloat(2.0f, 6.0f);
-            if (jt::Random::getChance()) {
-                topPos = rp + jt::Vector2f { maxWidth / 2, -maxHeight };
-                botPos = rp + jt::Vector2f { maxWidth, 0 };
-            } else {
-                topPos = rp + jt::Vector2f { -maxWidth / 2, -maxHeight };
-                botPos = rp + jt::Vector2f { -maxWidth, 0 };
-            }
-            auto const totalTime = jt::Random::getFloat(0.3f, 0.6f);
-            std::shared_ptr<jt::Tween> twp1
-                = jt::TweenPosition::create(s, totalTime / 2.0f, rp, topPos);
-            add(twp1);
-            twp1->addCompleteCallback([this, topPos, botPos, s, totalTime]() {
-                auto twp2 = jt::TweenPosition::create(s, totalTime / 2.0f, topPos, botPos);
-                add(twp2);
-            });
-        });
+    auto shape = std::make_shared<jt::Shape>();
+    shape->makeRect(jt::Vector2f { 1.0f, 1.0f }, textureManager());
+
+    m_walkParticles
+        = jt::ParticleBatch<50>::createPB(shape, [](jt::Particle& p, jt::Vector2f const& pos) {
+              p.position
+                  = pos + jt::Vector2f { 0, 4 } + jt::Vector2f { jt::Random::getFloat(-4, 4), 0 };
+              p.color = jt::colors::Black;
+              p.lifetime = jt::Random::getFloat(0.3f, 0.6f);
+
+              // jump to maxHeight at half of the lifetime and land maxWidth to the side
+              auto const maxHeight = jt::Random::getFloat(2.0f, 7.0f);
+              auto const maxWidth = jt::Random::getFloat(2.0f, 6.0f);
+              auto const direction = jt::Random::getChance() ? 1.0f : -1.0f;
+              p.velocity = jt::Vector2f { direction * maxWidth, -4.0f * maxHeight } / p.lifetime;
+              p.acceleration
+                  = jt::Vector2f { 0.0f, 8.0f * maxHeight / (p.lifetime * p.lifetime) };
+          });
+    m_walkParticles->setAlphaCurve({ { 0.0f, 1.0f }, { 1.0f, 0.0f } });
     add(m_walkParticles);
     m_player0->setWalkParticleSystem(m_walkParticles);
     m_player1->setWalkParticleSystem(m_walkParticles);
@@ -7,7 +7,7 @@
 #include <contact_callback_player_ground.hpp>
 #include <game_state.hpp>
 #include <level.hpp>
-#include <particle_system.hpp>
+#include <particle_batch.hpp>
 #include <platform_player.hpp>
 #include <screeneffects/vignette.hpp>
 #include <shape.hpp>
@@ -28,8 +28,8 @@ private:
     std::shared_ptr<Player> m_player1 { nullptr };
     std::shared_ptr<jt::Vignette> m_vignette { nullptr };
 
-    std::shared_ptr<jt::ParticleSystem<jt::Shape, 50>> m_walkParticles { nullptr };
-    std::shared_ptr<jt::ParticleSystem<jt::Shape, 50>> m_playerJumpParticles { nullptr };
+    std::shared_ptr<jt::ParticleBatch<50>> m_walkParticles { nullptr };
+    std::shared_ptr<jt::ParticleBatch<50>> m_playerJumpParticles { nullptr };
 
     bool m_ending { false };
 
@@ -17,6 +17,12 @@ void StateIntro::onCreate()
     m_fmodLogo->setOrigin(jt::Vector2f { 137.0f, 51.0f });
     m_fmodLogo->setPosition(GP::GetScreenSize());
     m_jingle = getGame()->audio().addTemporarySound("event:/intro");
+
+    // decode the textures of the following states while the intro is shown
+    for (auto const& fileName : { "assets/title_2.png", "assets/player.aseprite",
+             "assets/Player2.aseprite", "assets/postcards.aseprite" }) {
+        textureManager().prefetch(fileName);
+    }
 }
 
 void StateIntro::onEnter()
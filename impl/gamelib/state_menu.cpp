@@ -67,8 +67,8 @@ void StateMenu::createMenuText()
 
 void StateMenu::createTextExplanation()
 {
-    m_textExplanation = jt::dh::createText(
-        renderTarget(), GP::ExplanationText(), 16u, jt::Color { 245u, 203u, 92u, 255 });
+    m_textExplanation = jt::dh::createText(renderTarget(), getGame()->cache().getFontCache(),
+        GP::ExplanationText(), 16u, jt::Color { 245u, 203u, 92u, 255 });
     auto const half_width = GP::GetScreenSize().x / 2.0f;
     m_textExplanation->setPosition({ half_width, 100 });
     m_textExplanation->setShadow(jt::Color { 51u, 53u, 51u, 255u }, jt::Vector2f { 2, 2 });
@@ -76,7 +76,7 @@ void StateMenu::createTextExplanation()
 
 void StateMenu::createTextCredits()
 {
-    m_textCredits = jt::dh::createText(renderTarget(),
+    m_textCredits = jt::dh::createText(renderTarget(), getGame()->cache().getFontCache(),
         "Created by " + GP::AuthorName() + " for " + GP::JamName() + "\n" + GP::JamDate()
             + "\nF9 for License Information",
         14u, jt::Color { 47u, 184u, 218u, 255u });
@@ -84,7 +84,8 @@ void StateMenu::createTextCredits()
     m_textCredits->setPosition({ 10, GP::GetScreenSize().y - 70 });
     m_textCredits->setShadow({ 51u, 53u, 51u, 255u }, jt::Vector2f { 1, 1 });
 
-    m_textVersion = jt::dh::createText(renderTarget(), "", 14u, { 47u, 184u, 218u, 255u });
+    m_textVersion = jt::dh::createText(
+        renderTarget(), getGame()->cache().getFontCache(), "", 14u, { 47u, 184u, 218u, 255u });
     if (jt::BuildInfo::gitTagName() != "") {
         m_textVersion->setText(jt::BuildInfo::gitTagName());
     } else {
@@ -99,7 +100,8 @@ void StateMenu::createTextCredits()
 void StateMenu::createTextStart()
 {
     auto const half_width = GP::GetScreenSize().x / 2.0f;
-    m_textStart = jt::dh::createText(renderTarget(), "", 16u, GP::PaletteFontFront());
+    m_textStart = jt::dh::createText(
+        renderTarget(), getGame()->cache().getFontCache(), "", 16u, GP::PaletteFontFront());
     m_textStart->setPosition({ half_width, 70 });
     m_textStart->setShadow(GP::PaletteFontShadow(), jt::Vector2f { 2, 2 });
 }
@@ -11,7 +11,8 @@ void StateStartWithButton::onCreate()
     m_button = std::make_shared<jt::Button>(buttonSize, textureManager());
     m_button->addCallback(
         [this]() { getGame()->stateManager().switchState(std::make_shared<StateIntro>()); });
-    auto text = jt::dh::createText(renderTarget(), "Start", 24);
+    auto text
+        = jt::dh::createText(renderTarget(), getGame()->cache().getFontCache(), "Start", 24);
     text->setTextAlign(jt::Text::TextAlign::LEFT);
     text->setOrigin({ -34, -6 });
     m_button->setDrawable(text);
@@ -1,6 +1,8 @@
 #include "basic_action_commands.hpp"
 #include <game_base.hpp>
 #include <math_helper.hpp>
+#include <preload_helper.hpp>
+#include <exception>
 
 namespace {
 void addCommandHelp(std::shared_ptr<jt::GameBase>& game)
@@ -87,6 +89,55 @@ void addCommandTextureManager(std::shared_ptr<jt::GameBase>& game)
         [&logger = game->logger(), &textureManager = game->gfx().textureManager()](auto /*args*/) {
             logger.action(
                 "stored textures: " + std::to_string(textureManager.getNumberOfTextures()));
+            logger.action("texture memory: "
+                + std::to_string(textureManager.getMemoryUsage() / 1024u) + " KiB");
+        }));
+}
+
+void addCommandsAssetCache(std::shared_ptr<jt::GameBase>& game)
+{
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
+        "assetCache.info",
+        [&logger = game->logger(), &registry = game->cache().getAssetRegistry()](auto /*args*/) {
+            logger.action(
+                "asset memory: " + std::to_string(registry.getMemoryUsage() / 1024u) + " KiB");
+        }));
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
+        "assetCache.evict",
+        [&logger = game->logger(), &registry = game->cache().getAssetRegistry()](auto /*args*/) {
+            logger.action("evicted assets: " + std::to_string(registry.evictUnused()));
+        }));
+}
+
+void addCommandPreload(std::shared_ptr<jt::GameBase>& game)
+{
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand("preload",
+        [&logger = game->logger(), &textureManager = game->gfx().textureManager(),
+            &tilemapCache = game->cache().getTilemapCache()](auto args) {
+            if (args.size() != 3) {
+                logger.error("usage: preload <textures|tilemaps> <folder> <extension>");
+                return;
+            }
+            std::size_t numberOfFiles { 0u };
+            auto const progress = [&numberOfFiles](auto loaded, auto /*total*/) {
+                numberOfFiles = loaded;
+            };
+            try {
+                if (args.at(0) == "textures") {
+                    jt::PreloadHelper::preloadAllFrom(
+                        textureManager, args.at(1), args.at(2), true, progress);
+                } else if (args.at(0) == "tilemaps") {
+                    jt::PreloadHelper::preloadAllFrom(
+                        tilemapCache, args.at(1), args.at(2), true, progress);
+                } else {
+                    logger.error("unknown asset type '" + args.at(0) + "'");
+                    return;
+                }
+            } catch (std::exception const& e) {
+                logger.error(std::string { "preload failed: " } + e.what());
+                return;
+            }
+            logger.action("preloaded files: " + std::to_string(numberOfFiles));
         }));
 }
 
@@ -103,5 +154,7 @@ void jt::addBasicActionCommands(std::shared_ptr<jt::GameBase> game)
     addCommandClear(game);
     addCommandsCam(game);
     addCommandTextureManager(game);
+    addCommandsAssetCache(game);
+    addCommandPreload(game);
     addCommandsMusicPlayer(game);
 }
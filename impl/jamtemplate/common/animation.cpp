@@ -1,31 +1,14 @@
 ﻿#include "animation.hpp"
-#include <aselib/aseprite_data.hpp>
-#include <math_helper.hpp>
-#include <nlohmann.hpp>
 #include <sprite.hpp>
-#include <strutils.hpp>
 #include <system_helper.hpp>
 #include <texture_manager_interface.hpp>
-#include <fstream>
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
-namespace {
-
-std::shared_ptr<jt::Sprite>& getCurrentSprite(
-    jt::Animation::AnimationMapType& frames, std::string const& animName, size_t const animIndex)
-{
-    auto const cit = frames.find(animName);
-    if (cit == frames.cend()) {
-        throw std::invalid_argument { "AnimName: '" + animName + "' not part of animation" };
-    }
-
-    return cit->second.at(animIndex);
-}
-
-} // namespace
-
 void jt::Animation::add(std::string const& fileName, std::string const& animName,
     jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
     float frameTimeInSeconds, TextureManagerInterface& textureManager)
@@ -42,172 +25,74 @@ void jt::Animation::add(std::string const& fileName, std::string const& animName
     jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
     std::vector<float> const& frameTimesInSeconds, jt::TextureManagerInterface& textureManager)
 {
-    if (frameIndices.empty()) {
-        throw std::invalid_argument { "animation frame indices are empty." };
-    }
-    if (animName.empty()) {
-        throw std::invalid_argument { "animation name is empty." };
-    }
-    if (frameTimesInSeconds.empty()) {
-        throw std::invalid_argument { "frametimes are empty." };
-    }
-
-    if (frameTimesInSeconds.size() != frameIndices.size()) {
-        throw std::invalid_argument { "different sizes for frametimes and frame indices" };
-    }
-
-    if (m_frames.contains(animName)) {
-        std::cout << "Warning: Overwriting old animation with name: " << animName << std::endl;
-    }
-
-    m_frames[animName] = std::vector<jt::Sprite::Sptr> {};
-
-    for (auto const idx : frameIndices) {
-        jt::Recti const rect { static_cast<int>(idx * imageSize.x), 0,
-            static_cast<int>(imageSize.x), static_cast<int>(imageSize.y) };
-        auto sptr = std::make_shared<Sprite>(fileName, rect, textureManager);
-        m_frames[animName].push_back(sptr);
-    }
-    m_time[animName] = frameTimesInSeconds;
-    m_isLooping[animName] = true;
+    getMutableData().add(fileName, animName, imageSize, frameIndices, frameTimesInSeconds);
+    createSprites(textureManager);
+    updateCurrentFrame();
 }
 
 void jt::Animation::loadFromJson(
     std::string const& jsonFileName, TextureManagerInterface& textureManager)
 {
-    m_frames.clear();
-    m_time.clear();
-
-    if (!jsonFileName.ends_with(".json")) {
-        throw std::invalid_argument { "file '" + jsonFileName + "' is not a json file" };
-    }
-    if (!jt::SystemHelper::checkForValidFile(jsonFileName)) {
-        throw std::invalid_argument { "file '" + jsonFileName + "' is not a regular file" };
-    }
-
-    auto const filePathWithoutExtension = jsonFileName.substr(0, jsonFileName.length() - 5);
-
-    auto const imageFileName = filePathWithoutExtension + ".png";
-
-    auto const baseAnimName = strutil::split(filePathWithoutExtension, "/").back();
-
-    std::ifstream file { jsonFileName };
-    nlohmann::json j;
-    file >> j;
-
-    if (j.count("frames") == 0) {
-        throw std::invalid_argument { "json file does not have 'frames' entry" };
-    }
-    if (!j["frames"].is_object()) {
-        throw std::invalid_argument { "json 'frames' is not an array" };
-    }
-    if (j.count("meta") == 0) {
-        throw std::invalid_argument { "json file does not have 'meta' entry" };
-    }
-    if (j["meta"].count("frameTags") == 0) {
-        throw std::invalid_argument { "json file does not have 'meta.frameTags' entry" };
-    }
-    if (!j["meta"]["frameTags"].is_array()) {
-        throw std::invalid_argument { "json 'meta.frameTags' is not an array" };
-    }
-    for (auto const& frame : j["meta"]["frameTags"]) {
-        auto const animationName = frame["name"].get<std::string>();
-        auto const animationStart = frame["from"].get<unsigned int>();
-        auto const animationEnd = frame["to"].get<unsigned int>();
-
-        auto const frameIndices = jt::MathHelper::numbersBetween(animationStart, animationEnd);
-        std::vector<float> frameTimes;
-
-        auto const startFrameName = baseAnimName + " " + std::to_string(animationStart) + ".ase";
-        if (!j["frames"].contains(startFrameName)) {
-            throw std::invalid_argument { "'frames/" + startFrameName + "' does not exist" };
-        }
-        auto const width = j["frames"][startFrameName]["sourceSize"]["w"].get<unsigned int>();
-        auto const height = j["frames"][startFrameName]["sourceSize"]["h"].get<unsigned int>();
-
-        for (auto const id : frameIndices) {
-            auto const frameName = baseAnimName + " " + std::to_string(id) + ".ase";
-            if (j["frames"].count(frameName) == 0) {
-                throw std::invalid_argument { "json file does not have 'frames." + frameName
-                    + "' entry" };
-            }
-            if (j["frames"][frameName].count("duration") == 0) {
-                throw std::invalid_argument { "json file does not have 'frames." + frameName
-                    + ".duration' entry" };
-            }
-            auto const frameTime = j["frames"][frameName]["duration"].get<float>() / 1000.0f;
-            frameTimes.push_back(frameTime);
-        }
+    setData(jt::AnimationDataLoader::loadFromJson(jsonFileName), textureManager);
+}
 
-        add(imageFileName, animationName, jt::Vector2u { width, height }, frameIndices, frameTimes,
-            textureManager);
+void jt::Animation::setData(
+    std::shared_ptr<jt::AnimationData const> data, TextureManagerInterface& textureManager)
+{
+    if (!data) [[unlikely]] {
+        throw std::invalid_argument { "animation data must not be nullptr" };
     }
+    m_data = std::move(data);
+    m_ownedData = nullptr;
+    m_sprites.clear();
+    createSprites(textureManager);
+    updateCurrentFrame();
 }
 
 void jt::Animation::loadFromAseprite(
     std::string const& asepriteFileName, jt::TextureManagerInterface& textureManager)
 {
-    aselib::AsepriteData ase { asepriteFileName };
-
-    auto const imageSize
-        = jt::Vector2u { ase.m_header.m_width_in_pixel, ase.m_header.m_height_in_pixel };
-
-    if (ase.m_frames[0].m_chunks.m_tag_chunks.empty()) {
-        // no custom animation defined in aseprite, use all frames as default "idle" animation
-        std::vector<unsigned int> frameIDs
-            = jt::MathHelper::numbersBetween(0u, static_cast<unsigned int>(ase.m_frames.size()));
-
-        add(asepriteFileName, "idle", imageSize, frameIDs, 0.1f, textureManager);
-
+    auto const data = jt::AnimationDataLoader::loadFromAseprite(asepriteFileName);
+    if (!m_data || m_data->clips.empty()) {
+        m_data = data;
+        m_ownedData = nullptr;
     } else {
-        for (auto const& tagChunk : ase.m_frames[0].m_chunks.m_tag_chunks) {
-            for (auto const& tag : tagChunk.m_tags) {
-                auto const animName = tag.m_tag_name;
-                auto const startFrame = tag.m_from_frame;
-                auto const endFrame = tag.m_to_frame;
-                auto const repeat = tag.m_repeat_animation == 0;
-
-                std::vector<unsigned int> frameIDs = jt::MathHelper::numbersBetween(
-                    static_cast<unsigned int>(startFrame), static_cast<unsigned int>(endFrame));
-
-                std::vector<float> frame_times;
-                frame_times.resize(frameIDs.size());
-                std::transform(
-                    frameIDs.cbegin(), frameIDs.cend(), frame_times.begin(), [&ase](auto const id) {
-                        // aseprite stores the frametime in milliseconds, JT expects it in seconds.
-                        return ase.m_frames.at(id).m_frame_header.m_frame_duration / 1000.0f;
-                    });
-
-                add(asepriteFileName, animName, imageSize, frameIDs, frame_times, textureManager);
-                setLooping(animName, repeat);
+        // keep the animations added before
+        auto& ownData = getMutableData();
+        for (auto const& name : data->names) {
+            if (!ownData.clips.contains(name)) {
+                ownData.names.push_back(name);
             }
+            ownData.clips[name] = data->clips.at(name);
         }
     }
+    createSprites(textureManager);
+    updateCurrentFrame();
 }
 
 bool jt::Animation::hasAnimation(std::string const& animationName) const
 {
-    return (m_frames.contains(animationName));
+    return m_data && m_data->find(animationName) != nullptr;
 }
 
 std::vector<std::string> jt::Animation::getAllAvailableAnimationNames() const
 {
-    std::vector<std::string> names;
-    names.resize(m_frames.size());
-    std::transform(m_frames.cbegin(), m_frames.cend(), names.begin(),
-        [](auto kvp) -> std::string { return kvp.first; });
-
+    if (!m_data) {
+        return {};
+    }
+    auto names = m_data->names;
+    std::sort(names.begin(), names.end());
     return names;
 }
 
 std::string jt::Animation::getRandomAnimationName() const
 {
-    if (m_frames.empty()) {
+    if (!m_data || m_data->names.empty()) {
         throw std::invalid_argument {
             "can not get random animation name if no animation has been added"
         };
     }
-    return jt::SystemHelper::select_randomly(m_frames).first;
+    return jt::SystemHelper::select_randomly(m_data->names);
 }
 
 void jt::Animation::play(std::string const& animationName, size_t startFrameIndex, bool restart)
@@ -218,91 +103,71 @@ void jt::Animation::play(std::string const& animationName, size_t startFrameInde
         return;
     }
 
-    if (m_currentAnimName != animationName || restart) {
+    jt::StringId const animId { animationName };
+    if (m_currentAnimId != animId || restart) {
         m_currentIdx = startFrameIndex;
         m_currentAnimName = animationName;
+        m_currentAnimId = animId;
         m_frameTime = 0;
+        updateCurrentFrame();
+        markContentChanged();
     }
 }
 
 void jt::Animation::setColor(jt::Color const& col)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& spr : kvp.second) {
-            spr->setColor(col);
-        }
+    for (auto& kvp : m_sprites) {
+        kvp.second->setColor(col);
     }
 }
 
-jt::Color jt::Animation::getColor() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getColor();
-}
+jt::Color jt::Animation::getColor() const { return getCurrentSprite().getColor(); }
 
 void jt::Animation::setPosition(jt::Vector2f const& pos) { m_position = pos; }
 
 jt::Vector2f jt::Animation::getPosition() const { return m_position; }
 
-jt::Rectf jt::Animation::getGlobalBounds() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getGlobalBounds();
-}
+jt::Rectf jt::Animation::getGlobalBounds() const { return getCurrentSprite().getGlobalBounds(); }
 
-jt::Rectf jt::Animation::getLocalBounds() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getLocalBounds();
-}
+jt::Rectf jt::Animation::getLocalBounds() const { return getCurrentSprite().getLocalBounds(); }
 
 void jt::Animation::setScale(jt::Vector2f const& scale)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& spr : kvp.second) {
-            spr->setScale(scale);
-        }
+    for (auto& kvp : m_sprites) {
+        kvp.second->setScale(scale);
     }
 }
 
-jt::Vector2f jt::Animation::getScale() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getScale();
-}
+jt::Vector2f jt::Animation::getScale() const { return getCurrentSprite().getScale(); }
 
 void jt::Animation::setOriginInternal(jt::Vector2f const& origin)
 {
-    for (auto const& kvp : m_frames) {
-        for (auto const& sptr : kvp.second) {
-            sptr->setOrigin(origin);
-        }
+    for (auto const& kvp : m_sprites) {
+        kvp.second->setOrigin(origin);
     }
 }
 
 void jt::Animation::setOutline(jt::Color const& color, int width)
 {
     DrawableImpl::setOutline(color, width);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setOutline(color, width);
-        }
+    for (auto const& kvp : m_sprites) {
+        kvp.second->setOutline(color, width);
     }
 }
 
 void jt::Animation::setShadow(jt::Color const& color, jt::Vector2f const& offset)
 {
     DrawableImpl::setShadow(color, offset);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setShadow(color, offset);
-        }
+    for (auto const& kvp : m_sprites) {
+        kvp.second->setShadow(color, offset);
     }
 }
 
 void jt::Animation::setShadowActive(bool active)
 {
     DrawableImpl::setShadowActive(active);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setShadowActive(active);
-        }
+    for (auto const& kvp : m_sprites) {
+        kvp.second->setShadowActive(active);
     }
 }
 
@@ -317,18 +182,38 @@ void jt::Animation::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) co
                 + "'\n";
         return;
     }
-    m_frames.at(m_currentAnimName).at(m_currentIdx)->setBlendMode(getBlendMode());
-    m_frames.at(m_currentAnimName).at(m_currentIdx)->draw(sptr);
+    // pass on the position here as well, so positions set after update() are drawn correctly
+    m_currentSprite->setPosition(m_position + getShakeOffset() + getOffset());
+    m_currentSprite->setBlendMode(getBlendMode());
+    m_currentSprite->draw(sptr);
 }
 
 void jt::Animation::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const { }
 
+void jt::Animation::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
+{
+    if (!m_isValid) {
+        std::cerr << "Warning: Drawing Animation with invalid animName: '" + m_currentAnimName
+                + "'\n";
+        return;
+    }
+    auto const offset = getShakeOffset() + getOffset();
+    m_instancePositions.resize(positions.size());
+    std::transform(positions.begin(), positions.end(), m_instancePositions.begin(),
+        [&offset](auto const& position) { return position + offset; });
+
+    m_currentSprite->setBlendMode(getBlendMode());
+    m_currentSprite->drawInstances(sptr, m_instancePositions);
+}
+
+// frames are drawn as sprites, which use the render queue
+bool jt::Animation::usesRenderQueue() const { return true; }
+
 void jt::Animation::doFlashImpl(float t, jt::Color col)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->flash(t, col);
-        }
+    for (auto& kvp : m_sprites) {
+        kvp.second->flash(t, col);
     }
 }
 
@@ -342,53 +227,54 @@ void jt::Animation::doUpdate(float elapsed)
 
     // proceed time
     m_frameTime += elapsed * m_animationplaybackSpeed;
+    auto const oldIdx = m_currentIdx;
 
-    auto const frame_time = m_time[m_currentAnimName][m_currentIdx];
+    auto const& clip = *m_currentClip;
+    auto const frame_time = clip.frameTimes.at(m_currentIdx);
     // increase index
     while (m_frameTime >= frame_time) {
         m_frameTime -= frame_time;
         m_currentIdx++;
     }
     // wrap index or fix index at last frame
-    if (m_currentIdx >= m_frames.at(m_currentAnimName).size()) {
-        if (getCurrentAnimationIsLooping()) {
+    if (m_currentIdx >= clip.frameRects.size()) {
+        if (clip.looping) {
             m_currentIdx = 0;
         } else {
-            m_currentIdx = m_frames.at(m_currentAnimName).size() - 1;
+            m_currentIdx = clip.frameRects.size() - 1;
         }
     }
+    if (m_currentIdx != oldIdx) {
+        m_currentSprite->setTextureRect(clip.frameRects[m_currentIdx]);
+        markContentChanged();
+    }
 
     // update values for current sprite
-    auto const& currentSprite = m_frames.at(m_currentAnimName).at(m_currentIdx);
-    currentSprite->setPosition(m_position + getShakeOffset() + getOffset());
-    currentSprite->setIgnoreCamMovement(DrawableImpl::getIgnoreCamMovement());
-
-    // update all sprites
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->update(elapsed);
-        }
+    m_currentSprite->setPosition(m_position + getShakeOffset() + getOffset());
+    m_currentSprite->setIgnoreCamMovement(DrawableImpl::getIgnoreCamMovement());
+
+    // update all sprites, e.g. for flash
+    for (auto& kvp : m_sprites) {
+        kvp.second->update(elapsed);
     }
 }
 
 void jt::Animation::doRotate(float rot)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->setRotation(rot);
-        }
+    for (auto& kvp : m_sprites) {
+        kvp.second->setRotation(rot);
     }
 }
 
 float jt::Animation::getCurrentAnimationSingleFrameTime() const
 {
-    return m_time.at(m_currentAnimName).at(m_currentIdx);
+    return getCurrentClip().frameTimes.at(m_currentIdx);
 }
 
 float jt::Animation::getCurrentAnimTotalTime() const
 {
     float sum = 0.0f;
-    for (auto frameTime : m_time.at(m_currentAnimName)) {
+    for (auto frameTime : getCurrentClip().frameTimes) {
         sum += frameTime;
     }
     return sum;
@@ -400,7 +286,7 @@ float jt::Animation::getAnimTotalTimeFor(std::string const& animName)
         throw std::invalid_argument { "no animation with name " + animName };
     }
     float sum = 0.0f;
-    for (auto frameTime : m_time.at(animName)) {
+    for (auto frameTime : m_data->find(animName)->frameTimes) {
         sum += frameTime;
     }
     return sum;
@@ -408,17 +294,17 @@ float jt::Animation::getAnimTotalTimeFor(std::string const& animName)
 
 std::size_t jt::Animation::getNumberOfFramesInCurrentAnimation() const
 {
-    return m_frames.at(m_currentAnimName).size();
+    return getCurrentClip().frameRects.size();
 }
 
 std::string jt::Animation::getCurrentAnimationName() const { return m_currentAnimName; }
 
 bool jt::Animation::getCurrentAnimationIsLooping() const
 {
-    if (!hasAnimation(m_currentAnimName)) {
+    if (!m_currentClip) {
         return true;
     }
-    return m_isLooping.at(m_currentAnimName);
+    return m_currentClip->looping;
 }
 
 bool jt::Animation::getIsLoopingFor(std::string const& animName) const
@@ -426,7 +312,7 @@ bool jt::Animation::getIsLoopingFor(std::string const& animName) const
     if (!hasAnimation(animName)) {
         throw std::invalid_argument { "no animation with name " + animName };
     }
-    return m_isLooping.at(animName);
+    return m_data->find(animName)->looping;
 }
 
 void jt::Animation::setLooping(std::string const& animName, bool isLooping)
@@ -434,13 +320,16 @@ void jt::Animation::setLooping(std::string const& animName, bool isLooping)
     if (!hasAnimation(animName)) {
         throw std::invalid_argument { "invalid animation name: " + animName };
     }
-    m_isLooping[animName] = isLooping;
+    if (m_data->find(animName)->looping == isLooping) {
+        return;
+    }
+    getMutableData().clips.at(animName).looping = isLooping;
 }
 
 void jt::Animation::setLoopingAll(bool isLooping)
 {
-    for (auto& l : m_isLooping) {
-        l.second = isLooping;
+    for (auto& kvp : getMutableData().clips) {
+        kvp.second.looping = isLooping;
     }
 }
 
@@ -449,16 +338,70 @@ std::size_t jt::Animation::getCurrentAnimationFrameIndex() const { return m_curr
 void jt::Animation::setFrameTimes(
     std::string const& animationName, std::vector<float> const& frameTimes)
 {
-    if (!m_frames.contains(animationName)) {
+    if (!hasAnimation(animationName)) {
         throw std::invalid_argument { "cannot set frame times for invalid animation: "
             + animationName };
     }
-    if (frameTimes.size() != m_frames[animationName].size()) {
+    if (frameTimes.size() != m_data->find(animationName)->frameRects.size()) {
         throw std::invalid_argument { "frame times size does not match frame index size" };
     }
-    m_time[animationName] = frameTimes;
+    getMutableData().clips.at(animationName).frameTimes = frameTimes;
 }
 
 void jt::Animation::setAnimationSpeedFactor(float factor) { m_animationplaybackSpeed = factor; }
 
 float jt::Animation::getAnimationSpeedFactor() const { return m_animationplaybackSpeed; }
+
+jt::AnimationData& jt::Animation::getMutableData()
+{
+    if (!m_ownedData) {
+        // copy on write, the data might be shared with other animations
+        m_ownedData = m_data ? std::make_shared<jt::AnimationData>(*m_data)
+                             : std::make_shared<jt::AnimationData>();
+        m_data = m_ownedData;
+        m_currentClip = m_data->find(m_currentAnimId);
+    }
+    return *m_ownedData;
+}
+
+jt::AnimationClip const& jt::Animation::getCurrentClip() const
+{
+    if (!m_currentClip) {
+        throw std::invalid_argument { "AnimName: '" + m_currentAnimName
+            + "' not part of animation" };
+    }
+    return *m_currentClip;
+}
+
+jt::Sprite& jt::Animation::getCurrentSprite() const
+{
+    if (!m_currentSprite) {
+        throw std::invalid_argument { "AnimName: '" + m_currentAnimName
+            + "' not part of animation" };
+    }
+    return *m_currentSprite;
+}
+
+void jt::Animation::createSprites(jt::TextureManagerInterface& textureManager)
+{
+    for (auto const& kvp : m_data->clips) {
+        auto const& clip = kvp.second;
+        if (!m_sprites.contains(clip.fileName)) {
+            m_sprites[clip.fileName]
+                = std::make_shared<Sprite>(clip.fileName, clip.frameRects.front(), textureManager);
+        }
+    }
+}
+
+void jt::Animation::updateCurrentFrame()
+{
+    m_currentClip = m_data ? m_data->find(m_currentAnimId) : nullptr;
+    if (!m_currentClip) {
+        m_isValid = false;
+        m_currentSprite = nullptr;
+        return;
+    }
+    m_currentIdx = std::min(m_currentIdx, m_currentClip->frameRects.size() - 1u);
+    m_currentSprite = m_sprites.at(m_currentClip->fileName);
+    m_currentSprite->setTextureRect(m_currentClip->frameRects[m_currentIdx]);
+}
@@ -1,7 +1,9 @@
 ﻿#ifndef JAMTEMPLATE_ANIMATION_HPP
 #define JAMTEMPLATE_ANIMATION_HPP
 
+#include <animation_data.hpp>
 #include <graphics/drawable_impl.hpp>
+#include <string_id.hpp>
 #include <map>
 #include <memory>
 #include <string>
@@ -13,10 +15,11 @@ namespace jt {
 class Sprite;
 class TextureManagerInterface;
 
+/// Animation drawn from one or more images. Frame data is shared between all Animation instances
+/// loaded from the same file. Each instance only holds its playback state and one sprite per image.
 class Animation : public DrawableImpl {
 public:
     using Sptr = std::shared_ptr<Animation>;
-    using AnimationMapType = std::map<std::string, std::vector<std::shared_ptr<Sprite>>>;
 
     /// Add a new animation to the pool of available animations
     ///
@@ -46,6 +49,13 @@ public:
     /// \param textureManager the texture manager to load the individual sprites
     void loadFromJson(std::string const& jsonFileName, TextureManagerInterface& textureManager);
 
+    /// Use animation data loaded before, e.g. via jt::AssetRegistry. Animations added before are
+    /// replaced.
+    /// \param data the animation data, shared with other animations
+    /// \param textureManager the texture manager to load the individual sprites
+    void setData(
+        std::shared_ptr<jt::AnimationData const> data, TextureManagerInterface& textureManager);
+
     /// Load animation from aseprite file
     ///
     /// If there are no animations (tags) defined in the aseprite file, a default animation
@@ -173,13 +183,21 @@ public:
     float getAnimationSpeedFactor() const;
 
 private:
-    mutable AnimationMapType m_frames {};
-    std::map<std::string, std::vector<float>> m_time {};
+    // frame data, shared with other animations until it is modified
+    std::shared_ptr<jt::AnimationData const> m_data { nullptr };
+    // set if m_data is only used by this animation and can be modified
+    std::shared_ptr<jt::AnimationData> m_ownedData { nullptr };
+
+    // one sprite per image, drawn with the area of the current frame
+    std::map<jt::StringId, std::shared_ptr<Sprite>> m_sprites {};
 
     bool m_isValid { false };
 
     // which animation is playing atm?
     std::string m_currentAnimName { "" };
+    jt::StringId m_currentAnimId {};
+    jt::AnimationClip const* m_currentClip { nullptr };
+    std::shared_ptr<Sprite> m_currentSprite { nullptr };
     // which frame of the animation is currently displayed?
     std::size_t m_currentIdx { 0 };
 
@@ -187,20 +205,31 @@ private:
 
     float m_frameTime { 0.0f };
 
-    std::map<std::string, bool> m_isLooping {};
-
     float m_animationplaybackSpeed { 1.0f };
 
+    // scratch buffer for drawInstances, avoids allocations per draw
+    mutable std::vector<jt::Vector2f> m_instancePositions {};
+
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const override;
+    void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const override;
 
     void doFlashImpl(float t, jt::Color col = jt::colors::White) override;
 
     virtual void doUpdate(float elapsed) override;
 
     void doRotate(float rot) override;
+
+    bool usesRenderQueue() const override;
+
+    jt::AnimationData& getMutableData();
+    jt::AnimationClip const& getCurrentClip() const;
+    Sprite& getCurrentSprite() const;
+    void createSprites(TextureManagerInterface& textureManager);
+    void updateCurrentFrame();
 };
 
 } // namespace jt
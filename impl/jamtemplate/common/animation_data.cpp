@@ -0,0 +1,205 @@
+#include "animation_data.hpp"
+#include <aseprite_cache.hpp>
+#include <asset_pack/virtual_file_system.hpp>
+#include <math_helper.hpp>
+#include <nlohmann.hpp>
+#include <strutils.hpp>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+template <typename LoadFunction>
+std::shared_ptr<jt::AnimationData const> getShared(
+    std::string const& fileName, LoadFunction const& load)
+{
+    // only weak pointers are stored, so data is released when no animation uses it anymore
+    static std::mutex mutex;
+    static std::map<jt::StringId, std::weak_ptr<jt::AnimationData const>> loaded;
+
+    std::lock_guard const lock { mutex };
+    jt::StringId const id { fileName };
+    if (auto const it = loaded.find(id); it != loaded.end()) {
+        if (auto data = it->second.lock()) {
+            return data;
+        }
+    }
+    std::shared_ptr<jt::AnimationData const> data = load(fileName);
+    // drop files no animation uses anymore, so the map does not grow with every file ever loaded
+    std::erase_if(loaded, [](auto const& kvp) { return kvp.second.expired(); });
+    loaded[id] = data;
+    return data;
+}
+
+std::shared_ptr<jt::AnimationData> parseJson(std::string const& jsonFileName)
+{
+    ZoneScopedN("jt::AnimationDataLoader::parseJson");
+    if (!jsonFileName.ends_with(".json")) {
+        throw std::invalid_argument { "file '" + jsonFileName + "' is not a json file" };
+    }
+    if (!jt::VirtualFileSystem::exists(jsonFileName)) {
+        throw std::invalid_argument { "file '" + jsonFileName + "' is not a regular file" };
+    }
+
+    auto const filePathWithoutExtension = jsonFileName.substr(0, jsonFileName.length() - 5);
+
+    auto const imageFileName = filePathWithoutExtension + ".png";
+
+    auto const baseAnimName = strutil::split(filePathWithoutExtension, "/").back();
+
+    auto j = nlohmann::json::parse(jt::VirtualFileSystem::readFile(jsonFileName));
+
+    if (j.count("frames") == 0) {
+        throw std::invalid_argument { "json file does not have 'frames' entry" };
+    }
+    if (!j["frames"].is_object()) {
+        throw std::invalid_argument { "json 'frames' is not an array" };
+    }
+    if (j.count("meta") == 0) {
+        throw std::invalid_argument { "json file does not have 'meta' entry" };
+    }
+    if (j["meta"].count("frameTags") == 0) {
+        throw std::invalid_argument { "json file does not have 'meta.frameTags' entry" };
+    }
+    if (!j["meta"]["frameTags"].is_array()) {
+        throw std::invalid_argument { "json 'meta.frameTags' is not an array" };
+    }
+
+    auto data = std::make_shared<jt::AnimationData>();
+    for (auto const& frame : j["meta"]["frameTags"]) {
+        auto const animationName = frame["name"].get<std::string>();
+        auto const animationStart = frame["from"].get<unsigned int>();
+        auto const animationEnd = frame["to"].get<unsigned int>();
+
+        auto const frameIndices = jt::MathHelper::numbersBetween(animationStart, animationEnd);
+        std::vector<float> frameTimes;
+
+        auto const startFrameName = baseAnimName + " " + std::to_string(animationStart) + ".ase";
+        if (!j["frames"].contains(startFrameName)) {
+            throw std::invalid_argument { "'frames/" + startFrameName + "' does not exist" };
+        }
+        auto const width = j["frames"][startFrameName]["sourceSize"]["w"].get<unsigned int>();
+        auto const height = j["frames"][startFrameName]["sourceSize"]["h"].get<unsigned int>();
+
+        for (auto const id : frameIndices) {
+            auto const frameName = baseAnimName + " " + std::to_string(id) + ".ase";
+            if (j["frames"].count(frameName) == 0) {
+                throw std::invalid_argument { "json file does not have 'frames." + frameName
+                    + "' entry" };
+            }
+            if (j["frames"][frameName].count("duration") == 0) {
+                throw std::invalid_argument { "json file does not have 'frames." + frameName
+                    + ".duration' entry" };
+            }
+            auto const frameTime = j["frames"][frameName]["duration"].get<float>() / 1000.0f;
+            frameTimes.push_back(frameTime);
+        }
+
+        data->add(imageFileName, animationName, jt::Vector2u { width, height }, frameIndices,
+            frameTimes);
+    }
+    return data;
+}
+
+std::shared_ptr<jt::AnimationData> parseAseprite(std::string const& asepriteFileName)
+{
+    ZoneScopedN("jt::AnimationDataLoader::parseAseprite");
+    // only frames and tags are needed here, the image is decoded by the texture manager
+    auto const ase = jt::AsepriteCache::load(asepriteFileName, false);
+
+    auto const imageSize = jt::Vector2u { ase.frameWidth, ase.frameHeight };
+
+    auto data = std::make_shared<jt::AnimationData>();
+    if (ase.tags.empty()) {
+        // no custom animation defined in aseprite, use all frames as default "idle" animation
+        std::vector<unsigned int> frameIDs = jt::MathHelper::numbersBetween(
+            0u, static_cast<unsigned int>(ase.frameDurations.size()));
+        std::vector<float> frameTimes(frameIDs.size(), 0.1f);
+
+        data->add(asepriteFileName, "idle", imageSize, frameIDs, frameTimes);
+        return data;
+    }
+
+    for (auto const& tag : ase.tags) {
+        std::vector<unsigned int> frameIDs
+            = jt::MathHelper::numbersBetween(tag.fromFrame, tag.toFrame);
+
+        std::vector<float> frame_times;
+        frame_times.resize(frameIDs.size());
+        std::transform(frameIDs.cbegin(), frameIDs.cend(), frame_times.begin(),
+            [&ase](auto const id) { return ase.frameDurations.at(id); });
+
+        data->add(asepriteFileName, tag.name, imageSize, frameIDs, frame_times);
+        data->clips.at(tag.name).looping = tag.looping;
+    }
+    return data;
+}
+
+} // namespace
+
+void jt::AnimationData::add(std::string const& fileName, std::string const& animName,
+    jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
+    std::vector<float> const& frameTimesInSeconds)
+{
+    if (frameIndices.empty()) {
+        throw std::invalid_argument { "animation frame indices are empty." };
+    }
+    if (animName.empty()) {
+        throw std::invalid_argument { "animation name is empty." };
+    }
+    if (frameTimesInSeconds.empty()) {
+        throw std::invalid_argument { "frametimes are empty." };
+    }
+
+    if (frameTimesInSeconds.size() != frameIndices.size()) {
+        throw std::invalid_argument { "different sizes for frametimes and frame indices" };
+    }
+
+    jt::StringId const animId { animName };
+    if (clips.contains(animId)) {
+        std::cout << "Warning: Overwriting old animation with name: " << animName << std::endl;
+    } else {
+        names.push_back(animName);
+    }
+
+    AnimationClip clip { animName, fileName, {}, frameTimesInSeconds, true };
+    clip.frameRects.reserve(frameIndices.size());
+    for (auto const idx : frameIndices) {
+        clip.frameRects.emplace_back(static_cast<int>(idx * imageSize.x), 0,
+            static_cast<int>(imageSize.x), static_cast<int>(imageSize.y));
+    }
+    clips[animId] = std::move(clip);
+}
+
+jt::AnimationClip const* jt::AnimationData::find(jt::StringId animName) const
+{
+    auto const it = clips.find(animName);
+    return it == clips.cend() ? nullptr : &it->second;
+}
+
+std::shared_ptr<jt::AnimationData const> jt::AnimationDataLoader::loadFromJson(
+    std::string const& jsonFileName)
+{
+    return getShared(jsonFileName, parseJson);
+}
+
+std::shared_ptr<jt::AnimationData const> jt::AnimationDataLoader::loadFromAseprite(
+    std::string const& asepriteFileName)
+{
+    return getShared(asepriteFileName, parseAseprite);
+}
+
+std::shared_ptr<jt::AnimationData const> jt::AnimationDataLoader::createFromJson(
+    std::string const& jsonFileName)
+{
+    return parseJson(jsonFileName);
+}
+
+std::shared_ptr<jt::AnimationData const> jt::AnimationDataLoader::createFromAseprite(
+    std::string const& asepriteFileName)
+{
+    return parseAseprite(asepriteFileName);
+}
@@ -0,0 +1,78 @@
+#ifndef JAMTEMPLATE_ANIMATION_DATA_HPP
+#define JAMTEMPLATE_ANIMATION_DATA_HPP
+
+#include <rect.hpp>
+#include <string_id.hpp>
+#include <vector.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Frames of a single animation, e.g. "walk"
+struct AnimationClip {
+    std::string name { "" };
+    /// texture identifier of the image containing the frames
+    std::string fileName { "" };
+    /// area of the texture for each frame
+    std::vector<jt::Recti> frameRects {};
+    /// duration of each frame in seconds
+    std::vector<float> frameTimes {};
+    bool looping { true };
+};
+
+/// Animations which can be shared between Animation instances, e.g. all animations of a file.
+/// Playback state (current animation, frame, position) is stored in the Animation instances.
+struct AnimationData {
+    std::map<jt::StringId, AnimationClip> clips {};
+    /// names of the clips in the order they were added
+    std::vector<std::string> names {};
+
+    /// Add or replace an animation clip
+    /// \param fileName texture identifier of the image containing the frames
+    /// \param animName name of the animation
+    /// \param imageSize size of a single frame. Frames are placed next to each other in the image.
+    /// \param frameIndices frames which are part of this animation
+    /// \param frameTimesInSeconds duration of each frame
+    void add(std::string const& fileName, std::string const& animName,
+        jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
+        std::vector<float> const& frameTimesInSeconds);
+
+    /// Find an animation clip
+    /// \param animName name of the animation
+    /// \return pointer to the clip, nullptr if no animation with that name was added
+    AnimationClip const* find(jt::StringId animName) const;
+};
+
+namespace AnimationDataLoader {
+
+/// Load animations from json file. Data of files which are still in use by other animations is
+/// shared instead of parsed again.
+/// \param jsonFileName path to the json file, needs to be next to the image file
+/// \return the animation data
+std::shared_ptr<AnimationData const> loadFromJson(std::string const& jsonFileName);
+
+/// Load animations from aseprite file. Data of files which are still in use by other animations
+/// is shared instead of loaded again. If no tags are defined, a single animation "idle" with all
+/// frames is created.
+/// \param asepriteFileName path to the aseprite file
+/// \return the animation data
+std::shared_ptr<AnimationData const> loadFromAseprite(std::string const& asepriteFileName);
+
+/// Load animations from json file without sharing, for caches that own the data themselves, e.g.
+/// the AnimationData loader of jt::AssetRegistry
+/// \param jsonFileName path to the json file, needs to be next to the image file
+/// \return the animation data
+std::shared_ptr<AnimationData const> createFromJson(std::string const& jsonFileName);
+
+/// Load animations from aseprite file without sharing, for caches that own the data themselves
+/// \param asepriteFileName path to the aseprite file
+/// \return the animation data
+std::shared_ptr<AnimationData const> createFromAseprite(std::string const& asepriteFileName);
+
+} // namespace AnimationDataLoader
+} // namespace jt
+
+#endif // JAMTEMPLATE_ANIMATION_DATA_HPP
@@ -0,0 +1,315 @@
+#include "aseprite_cache.hpp"
+#include <aselib/aseprite_data.hpp>
+#include <aselib/image_builder.hpp>
+#include <string_id.hpp>
+#include <strutils.hpp>
+#include <tracy/Tracy.hpp>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace {
+
+constexpr std::array<char, 4> cacheMagic { 'J', 'T', 'A', 'C' };
+// increase when the layout of the cache file changes, so old cache files are not read
+constexpr std::uint32_t cacheVersion { 1u };
+constexpr char const* cacheFolder { ".jt_cache/aseprite" };
+
+// limits for values read from cache files, so a corrupt file does not cause huge allocations
+constexpr std::uint32_t maxCount { 1u << 16 };
+constexpr std::uint32_t maxImageSize { 1u << 14 };
+
+std::uint64_t hashFileContent(std::string const& fileName)
+{
+    std::ifstream file { fileName, std::ios::binary };
+    std::array<char, 4096> buffer {};
+    auto hash = jt::fnvOffsetBasis;
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = jt::fnv1a(
+            std::string_view { buffer.data(), static_cast<std::size_t>(file.gcount()) }, hash);
+    }
+    return hash;
+}
+
+/// Values which identify the version of an aseprite file
+struct FileStamp {
+    std::int64_t modificationTime { 0 };
+    std::uint64_t size { 0u };
+};
+
+template <typename T>
+void writeValue(std::ostream& out, T const& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readValue(std::istream& in)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value {};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+void writeString(std::ostream& out, std::string const& str)
+{
+    writeValue(out, static_cast<std::uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+std::string readString(std::istream& in)
+{
+    auto const size = readValue<std::uint32_t>(in);
+    if (!in || size > maxCount) {
+        in.setstate(std::ios::failbit);
+        return "";
+    }
+    std::string str(size, '\0');
+    in.read(str.data(), static_cast<std::streamsize>(size));
+    return str;
+}
+
+std::filesystem::path getCachePath(std::string const& identifier)
+{
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0')
+         << jt::StringId { identifier }.getHash() << ".bin";
+    return std::filesystem::path { cacheFolder } / name.str();
+}
+
+jt::DecodedAseprite decode(
+    std::string const& identifier, std::string const& fileName, bool withPixels)
+{
+    ZoneScopedN("jt::AsepriteCache::decode");
+    aselib::AsepriteData aseData { fileName };
+
+    jt::DecodedAseprite decoded {};
+    decoded.frameWidth = aseData.m_header.m_width_in_pixel;
+    decoded.frameHeight = aseData.m_header.m_height_in_pixel;
+    for (auto const& frame : aseData.m_frames) {
+        // aseprite stores the frametime in milliseconds, JT expects it in seconds.
+        decoded.frameDurations.push_back(frame.m_frame_header.m_frame_duration / 1000.0f);
+    }
+    if (!aseData.m_frames.empty()) {
+        for (auto const& tagChunk : aseData.m_frames[0].m_chunks.m_tag_chunks) {
+            for (auto const& tag : tagChunk.m_tags) {
+                decoded.tags.push_back(jt::DecodedAseprite::Tag { tag.m_tag_name,
+                    static_cast<unsigned int>(tag.m_from_frame),
+                    static_cast<unsigned int>(tag.m_to_frame), tag.m_repeat_animation == 0 });
+            }
+        }
+    }
+    if (!withPixels) {
+        // compositing the layers is the expensive part. Frames are placed side by side.
+        decoded.width = decoded.frameWidth * static_cast<unsigned int>(aseData.m_frames.size());
+        decoded.height = decoded.frameHeight;
+        return decoded;
+    }
+
+    auto const postFix = identifier.substr(fileName.size());
+    std::unique_ptr<aselib::Image> aseImage { nullptr };
+    if (strutil::contains(postFix, ".layer=")) {
+        auto const layerPos = postFix.find(".layer=");
+        auto const layerName = postFix.substr(layerPos + 7);
+        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
+    } else {
+        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
+        aseImage = std::make_unique<aselib::Image>(
+            aselib::makeImageFromAse(aseData, !ignore_transparent));
+    }
+
+    decoded.width = aseImage->m_width;
+    decoded.height = aseImage->m_height;
+    decoded.pixels.resize(static_cast<std::size_t>(decoded.width) * decoded.height * 4u);
+    for (auto j = 0u; j != decoded.height; ++j) {
+        for (auto i = 0u; i != decoded.width; ++i) {
+            auto const& p = aseImage->getPixelAt(i, j);
+            auto const index = (static_cast<std::size_t>(j) * decoded.width + i) * 4u;
+            decoded.pixels[index + 0u] = p.r;
+            decoded.pixels[index + 1u] = p.g;
+            decoded.pixels[index + 2u] = p.b;
+            decoded.pixels[index + 3u] = p.a;
+        }
+    }
+    return decoded;
+}
+
+std::optional<jt::DecodedAseprite> readCacheFile(std::filesystem::path const& cachePath,
+    std::string const& identifier, std::string const& fileName, FileStamp const& stamp,
+    bool withPixels)
+{
+    std::ifstream in { cachePath, std::ios::binary };
+    if (!in) {
+        return std::nullopt;
+    }
+    auto const magic = readValue<std::array<char, 4>>(in);
+    auto const version = readValue<std::uint32_t>(in);
+    // different identifiers with the same hash use the same cache file
+    if (!in || magic != cacheMagic || version != cacheVersion || readString(in) != identifier) {
+        return std::nullopt;
+    }
+
+    auto const modificationTimePosition = in.tellg();
+    auto const cachedStamp = readValue<FileStamp>(in);
+    auto const contentHash = readValue<std::uint64_t>(in);
+    if (!in || cachedStamp.size != stamp.size) {
+        return std::nullopt;
+    }
+    if (cachedStamp.modificationTime != stamp.modificationTime) {
+        // the file was touched, e.g. by a checkout, but its content might be the same
+        if (hashFileContent(fileName) != contentHash) {
+            return std::nullopt;
+        }
+        std::fstream update { cachePath, std::ios::binary | std::ios::in | std::ios::out };
+        update.seekp(modificationTimePosition);
+        writeValue(update, stamp);
+    }
+
+    jt::DecodedAseprite decoded {};
+    decoded.frameWidth = readValue<std::uint32_t>(in);
+    decoded.frameHeight = readValue<std::uint32_t>(in);
+    auto const numberOfFrames = readValue<std::uint32_t>(in);
+    if (!in || numberOfFrames > maxCount) {
+        return std::nullopt;
+    }
+    decoded.frameDurations.resize(numberOfFrames);
+    in.read(reinterpret_cast<char*>(decoded.frameDurations.data()),
+        static_cast<std::streamsize>(numberOfFrames * sizeof(float)));
+
+    auto const numberOfTags = readValue<std::uint32_t>(in);
+    if (!in || numberOfTags > maxCount) {
+        return std::nullopt;
+    }
+    for (auto i = 0u; i != numberOfTags; ++i) {
+        jt::DecodedAseprite::Tag tag {};
+        tag.name = readString(in);
+        tag.fromFrame = readValue<std::uint32_t>(in);
+        tag.toFrame = readValue<std::uint32_t>(in);
+        tag.looping = readValue<std::uint8_t>(in) != 0u;
+        // frame indices are used without further checks, so a corrupt file is decoded again
+        if (!in || tag.fromFrame > tag.toFrame || tag.toFrame >= numberOfFrames) {
+            return std::nullopt;
+        }
+        decoded.tags.push_back(tag);
+    }
+
+    decoded.width = readValue<std::uint32_t>(in);
+    decoded.height = readValue<std::uint32_t>(in);
+    if (!in || decoded.width > maxImageSize || decoded.height > maxImageSize) {
+        return std::nullopt;
+    }
+    if (withPixels) {
+        // pixels are stored last, so they are read in one go and skipped for metadata requests
+        decoded.pixels.resize(static_cast<std::size_t>(decoded.width) * decoded.height * 4u);
+        in.read(reinterpret_cast<char*>(decoded.pixels.data()),
+            static_cast<std::streamsize>(decoded.pixels.size()));
+        if (!in) {
+            return std::nullopt;
+        }
+    }
+    return decoded;
+}
+
+void writeCacheFile(std::filesystem::path const& cachePath, std::string const& identifier,
+    FileStamp const& stamp, std::uint64_t contentHash, jt::DecodedAseprite const& decoded)
+{
+    // the cache is optional, so failing to write it is not an error
+    std::error_code ec;
+    std::filesystem::create_directories(cachePath.parent_path(), ec);
+    if (ec) {
+        return;
+    }
+
+    // write to a temporary file first, so other threads never read a partially written file
+    auto tempPath = cachePath;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+    {
+        std::ofstream out { tempPath, std::ios::binary | std::ios::trunc };
+        writeValue(out, cacheMagic);
+        writeValue(out, cacheVersion);
+        writeString(out, identifier);
+        writeValue(out, stamp);
+        writeValue(out, contentHash);
+
+        writeValue(out, static_cast<std::uint32_t>(decoded.frameWidth));
+        writeValue(out, static_cast<std::uint32_t>(decoded.frameHeight));
+        writeValue(out, static_cast<std::uint32_t>(decoded.frameDurations.size()));
+        out.write(reinterpret_cast<char const*>(decoded.frameDurations.data()),
+            static_cast<std::streamsize>(decoded.frameDurations.size() * sizeof(float)));
+        writeValue(out, static_cast<std::uint32_t>(decoded.tags.size()));
+        for (auto const& tag : decoded.tags) {
+            writeString(out, tag.name);
+            writeValue(out, static_cast<std::uint32_t>(tag.fromFrame));
+            writeValue(out, static_cast<std::uint32_t>(tag.toFrame));
+            writeValue(out, static_cast<std::uint8_t>(tag.looping ? 1u : 0u));
+        }
+
+        writeValue(out, static_cast<std::uint32_t>(decoded.width));
+        writeValue(out, static_cast<std::uint32_t>(decoded.height));
+        out.write(reinterpret_cast<char const*>(decoded.pixels.data()),
+            static_cast<std::streamsize>(decoded.pixels.size()));
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+} // namespace
+
+jt::DecodedAseprite jt::AsepriteCache::load(std::string const& identifier, bool withPixels)
+{
+    ZoneScopedN("jt::AsepriteCache::load");
+    auto const asepritePos = identifier.rfind(".aseprite");
+    if (asepritePos == std::string::npos) {
+        throw std::invalid_argument { "'" + identifier + "' is not an aseprite file name" };
+    }
+    auto const fileName = identifier.substr(0, asepritePos + 9);
+
+#if JT_ENABLE_WEB
+    // files written in the browser do not survive a reload, so there is nothing to cache
+    return decode(identifier, fileName, withPixels);
+#else
+    std::error_code sizeError;
+    std::error_code timeError;
+    auto const fileSize = std::filesystem::file_size(fileName, sizeError);
+    auto const modificationTime = std::filesystem::last_write_time(fileName, timeError);
+    if (sizeError || timeError) {
+        // let aselib report the missing file
+        return decode(identifier, fileName, withPixels);
+    }
+    FileStamp const stamp { static_cast<std::int64_t>(modificationTime.time_since_epoch().count()),
+        static_cast<std::uint64_t>(fileSize) };
+
+    auto const cachePath = getCachePath(identifier);
+    if (auto cached = readCacheFile(cachePath, identifier, fileName, stamp, withPixels)) {
+        return std::move(*cached);
+    }
+
+    if (!withPixels) {
+        // the cache file needs the pixels, it is written when the image is loaded
+        return decode(identifier, fileName, false);
+    }
+    auto decoded = decode(identifier, fileName, true);
+    writeCacheFile(cachePath, identifier, stamp, hashFileContent(fileName), decoded);
+    return decoded;
+#endif
+}
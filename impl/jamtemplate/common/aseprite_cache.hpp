@@ -0,0 +1,49 @@
+#ifndef JAMTEMPLATE_ASEPRITE_CACHE_HPP
+#define JAMTEMPLATE_ASEPRITE_CACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Composited image and animation data of an aseprite file
+struct DecodedAseprite {
+    /// Animation tag defined in aseprite
+    struct Tag {
+        std::string name { "" };
+        unsigned int fromFrame { 0u };
+        unsigned int toFrame { 0u };
+        bool looping { true };
+    };
+
+    /// size of the composited image in pixel
+    unsigned int width { 0u };
+    unsigned int height { 0u };
+    /// RGBA values of the composited image, row by row. Empty if only the metadata was requested.
+    std::vector<std::uint8_t> pixels {};
+
+    /// size of a single frame in pixel
+    unsigned int frameWidth { 0u };
+    unsigned int frameHeight { 0u };
+    /// duration of each frame in seconds
+    std::vector<float> frameDurations {};
+    std::vector<Tag> tags {};
+};
+
+namespace AsepriteCache {
+
+/// Decode an aseprite file. The decoded data is stored in a cache file, so following runs read the
+/// cache file instead of parsing the file and compositing its layers again. A cache file is used
+/// as long as modification time or content hash of the aseprite file did not change. Can be
+/// called from worker threads.
+/// \param identifier aseprite file name, optionally with the ".layer=<name>" or
+/// ".ignore_transparent" postfix used by the texture managers
+/// \param withPixels false to only get the frame and tag data, e.g. for animations
+/// \return the decoded data
+DecodedAseprite load(std::string const& identifier, bool withPixels = true);
+
+} // namespace AsepriteCache
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASEPRITE_CACHE_HPP
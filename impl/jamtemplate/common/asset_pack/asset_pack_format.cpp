@@ -0,0 +1,12 @@
+#include "asset_pack_format.hpp"
+#include <algorithm>
+
+std::string jt::AssetPack::normalizePath(std::string_view path)
+{
+    std::string normalized { path };
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.starts_with("./")) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
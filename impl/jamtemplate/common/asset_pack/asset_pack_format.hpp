@@ -0,0 +1,84 @@
+#ifndef JAMTEMPLATE_ASSET_PACK_FORMAT_HPP
+#define JAMTEMPLATE_ASSET_PACK_FORMAT_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace jt {
+namespace AssetPack {
+
+// Layout of a pack file, all numbers are stored little endian:
+//  - Header
+//  - IndexEntry for every file, sorted by hash
+//  - contents of all files
+constexpr std::array<char, 4> magic { 'J', 'T', 'P', 'K' };
+constexpr std::uint32_t version { 1u };
+
+struct Header {
+    std::array<char, 4> magic {};
+    std::uint32_t version { 0u };
+    std::uint64_t numberOfFiles { 0u };
+};
+
+struct IndexEntry {
+    /// StringId hash of the normalized path
+    std::uint64_t hash { 0u };
+    /// offset of the file contents from the start of the pack
+    std::uint64_t offset { 0u };
+    std::uint64_t size { 0u };
+};
+
+static_assert(sizeof(Header) == 16u);
+static_assert(sizeof(IndexEntry) == 24u);
+
+/// Convert a number from native to little endian byte order or back
+/// \param value the number
+/// \return the number with swapped bytes on big endian platforms, the number otherwise
+template <std::unsigned_integral T>
+constexpr T convertLittleEndian(T value) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        return value;
+    } else {
+        T swapped { 0u };
+        for (std::size_t i = 0u; i != sizeof(T); ++i) {
+            swapped = static_cast<T>((swapped << 8u) | (value & 0xFFu));
+            value = static_cast<T>(value >> 8u);
+        }
+        return swapped;
+    }
+}
+
+/// Convert all numbers of a header between native and little endian byte order
+/// \param header the header
+/// \return the converted header
+constexpr Header convertLittleEndian(Header const& header) noexcept
+{
+    return Header { header.magic, convertLittleEndian(header.version),
+        convertLittleEndian(header.numberOfFiles) };
+}
+
+/// Convert all numbers of an index entry between native and little endian byte order
+/// \param entry the index entry
+/// \return the converted index entry
+constexpr IndexEntry convertLittleEndian(IndexEntry const& entry) noexcept
+{
+    return IndexEntry { convertLittleEndian(entry.hash), convertLittleEndian(entry.offset),
+        convertLittleEndian(entry.size) };
+}
+
+/// Normalize a path, so the same file always results in the same hash, e.g. "./assets\\a.png"
+/// becomes "assets/a.png"
+/// \param path the path to normalize
+/// \return the normalized path
+std::string normalizePath(std::string_view path);
+
+} // namespace AssetPack
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASSET_PACK_FORMAT_HPP
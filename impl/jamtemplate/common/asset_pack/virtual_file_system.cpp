@@ -0,0 +1,187 @@
+#include "virtual_file_system.hpp"
+#include <asset_pack/asset_pack_format.hpp>
+#include <string_id.hpp>
+#include <system_helper.hpp>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(JT_ENABLE_WEB)
+#define JT_ASSET_PACK_USE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+class MountedPack {
+public:
+    explicit MountedPack(std::string const& packFileName)
+    {
+        open(packFileName);
+        readIndex(packFileName);
+    }
+
+    ~MountedPack()
+    {
+#if JT_ASSET_PACK_USE_MMAP
+        if (m_mapped != nullptr) {
+            munmap(m_mapped, m_size);
+        }
+#endif
+    }
+
+    MountedPack(MountedPack const&) = delete;
+    MountedPack& operator=(MountedPack const&) = delete;
+
+    std::optional<std::span<char const>> find(std::uint64_t hash) const
+    {
+        auto const it = std::lower_bound(m_index.cbegin(), m_index.cend(), hash,
+            [](auto const& entry, auto const value) { return entry.hash < value; });
+        if (it == m_index.cend() || it->hash != hash) {
+            return std::nullopt;
+        }
+        return std::span<char const> { m_data + it->offset, static_cast<std::size_t>(it->size) };
+    }
+
+    std::size_t getNumberOfFiles() const { return m_index.size(); }
+
+private:
+    char const* m_data { nullptr };
+    std::size_t m_size { 0u };
+    std::vector<jt::AssetPack::IndexEntry> m_index {};
+#if JT_ASSET_PACK_USE_MMAP
+    void* m_mapped { nullptr };
+#else
+    std::vector<char> m_buffer {};
+#endif
+
+    void open(std::string const& packFileName)
+    {
+#if JT_ASSET_PACK_USE_MMAP
+        auto const fd = ::open(packFileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument { "cannot open asset pack '" + packFileName + "'" };
+        }
+        struct stat fileStat { };
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+            ::close(fd);
+            throw std::invalid_argument { "cannot read asset pack '" + packFileName + "'" };
+        }
+        m_size = static_cast<std::size_t>(fileStat.st_size);
+        auto* const mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping stays valid after the file is closed
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::invalid_argument { "cannot map asset pack '" + packFileName + "'" };
+        }
+        m_mapped = mapped;
+        m_data = static_cast<char const*>(mapped);
+#else
+        std::ifstream file { packFileName, std::ios::binary };
+        if (!file) {
+            throw std::invalid_argument { "cannot open asset pack '" + packFileName + "'" };
+        }
+        m_buffer.assign(std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {});
+        m_size = m_buffer.size();
+        m_data = m_buffer.data();
+#endif
+    }
+
+    void readIndex(std::string const& packFileName)
+    {
+        jt::AssetPack::Header header {};
+        if (m_size < sizeof(header)) {
+            throw std::invalid_argument { "'" + packFileName + "' is not an asset pack" };
+        }
+        std::memcpy(&header, m_data, sizeof(header));
+        header = jt::AssetPack::convertLittleEndian(header);
+        if (header.magic != jt::AssetPack::magic) {
+            throw std::invalid_argument { "'" + packFileName + "' is not an asset pack" };
+        }
+        if (header.version != jt::AssetPack::version) {
+            throw std::invalid_argument { "asset pack '" + packFileName
+                + "' has unsupported version " + std::to_string(header.version) };
+        }
+        if ((m_size - sizeof(header)) / sizeof(jt::AssetPack::IndexEntry)
+            < header.numberOfFiles) {
+            throw std::invalid_argument { "asset pack '" + packFileName + "' is truncated" };
+        }
+
+        // copied, so lookups do not depend on the alignment of the mapped data
+        m_index.resize(static_cast<std::size_t>(header.numberOfFiles));
+        std::memcpy(m_index.data(), m_data + sizeof(header),
+            m_index.size() * sizeof(jt::AssetPack::IndexEntry));
+        for (auto& entry : m_index) {
+            entry = jt::AssetPack::convertLittleEndian(entry);
+            if (entry.offset > m_size || entry.size > m_size - entry.offset) {
+                throw std::invalid_argument { "asset pack '" + packFileName + "' is truncated" };
+            }
+        }
+    }
+};
+
+std::vector<std::unique_ptr<MountedPack>>& getMountedPacks()
+{
+    static std::vector<std::unique_ptr<MountedPack>> packs {};
+    return packs;
+}
+
+} // namespace
+
+void jt::VirtualFileSystem::mount(std::string const& packFileName)
+{
+    ZoneScopedN("jt::VirtualFileSystem::mount");
+    getMountedPacks().push_back(std::make_unique<MountedPack>(packFileName));
+}
+
+void jt::VirtualFileSystem::unmountAll() { getMountedPacks().clear(); }
+
+std::size_t jt::VirtualFileSystem::getNumberOfPackedFiles()
+{
+    std::size_t numberOfFiles { 0u };
+    for (auto const& pack : getMountedPacks()) {
+        numberOfFiles += pack->getNumberOfFiles();
+    }
+    return numberOfFiles;
+}
+
+std::optional<std::span<char const>> jt::VirtualFileSystem::findInPack(std::string_view fileName)
+{
+    auto const& packs = getMountedPacks();
+    if (packs.empty()) [[likely]] {
+        return std::nullopt;
+    }
+    auto const hash = jt::StringId { jt::AssetPack::normalizePath(fileName) }.getHash();
+    for (auto it = packs.crbegin(); it != packs.crend(); ++it) {
+        if (auto const data = (*it)->find(hash)) {
+            return data;
+        }
+    }
+    return std::nullopt;
+}
+
+bool jt::VirtualFileSystem::exists(std::string const& fileName)
+{
+    return findInPack(fileName).has_value() || jt::SystemHelper::checkForValidFile(fileName);
+}
+
+std::string jt::VirtualFileSystem::readFile(std::string const& fileName)
+{
+    if (auto const data = findInPack(fileName)) {
+        return std::string { data->begin(), data->end() };
+    }
+    std::ifstream file { fileName, std::ios::binary };
+    if (!file) {
+        throw std::invalid_argument { "cannot open file '" + fileName + "'" };
+    }
+    return std::string { std::istreambuf_iterator<char> { file },
+        std::istreambuf_iterator<char> {} };
+}
@@ -0,0 +1,49 @@
+#ifndef JAMTEMPLATE_VIRTUAL_FILE_SYSTEM_HPP
+#define JAMTEMPLATE_VIRTUAL_FILE_SYSTEM_HPP
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace jt {
+
+/// Read access to asset files, either from mounted asset packs or from disk. Packs are memory
+/// mapped where the platform supports it, so files from packs are not copied when they are read.
+/// Mounting and unmounting is not thread safe and needs to happen before assets are loaded,
+/// lookups can happen from multiple threads.
+namespace VirtualFileSystem {
+
+/// Mount an asset pack. Files in packs mounted later take precedence over files in packs mounted
+/// earlier.
+/// \param packFileName path to the pack file
+void mount(std::string const& packFileName);
+
+/// Unmount all asset packs. Data returned by findInPack is invalid afterwards.
+void unmountAll();
+
+/// Get the number of files in all mounted packs
+/// \return number of files
+std::size_t getNumberOfPackedFiles();
+
+/// Find a file in the mounted asset packs
+/// \param fileName path of the file, e.g. "assets/player.png"
+/// \return the file contents, valid until the packs are unmounted. Empty optional if the file is
+///         not in any mounted pack.
+std::optional<std::span<char const>> findInPack(std::string_view fileName);
+
+/// Check if a file exists in a mounted asset pack or on disk
+/// \param fileName path of the file
+/// \return true if the file exists
+bool exists(std::string const& fileName);
+
+/// Read a file from the mounted asset packs, or from disk if it is not packed
+/// \param fileName path of the file
+/// \return the file contents
+std::string readFile(std::string const& fileName);
+
+} // namespace VirtualFileSystem
+} // namespace jt
+
+#endif // JAMTEMPLATE_VIRTUAL_FILE_SYSTEM_HPP
@@ -1,4 +1,5 @@
 #include "audio_impl.hpp"
+#include <asset_pack/virtual_file_system.hpp>
 #include <audio/sound/sound.hpp>
 #include <random/random.hpp>
 #include <tracy/Tracy.hpp>
@@ -14,6 +15,21 @@ FMOD_STUDIO_INITFLAGS getStudioInitFlags()
     return FMOD_STUDIO_INIT_LIVEUPDATE;
 #endif
 }
+
+FMOD::Studio::Bank* loadBank(FMOD::Studio::System* studioSystem, std::string const& fileName)
+{
+    FMOD::Studio::Bank* bank { nullptr };
+    if (auto const data = jt::VirtualFileSystem::findInPack(fileName)) {
+        // FMOD copies the data, so the bank stays valid if the pack is unmounted
+        jt::checkResult(studioSystem->loadBankMemory(data->data(),
+            static_cast<int>(data->size()), FMOD_STUDIO_LOAD_MEMORY, FMOD_STUDIO_LOAD_BANK_NORMAL,
+            &bank));
+        return bank;
+    }
+    jt::checkResult(
+        studioSystem->loadBankFile(fileName.c_str(), FMOD_STUDIO_LOAD_BANK_NORMAL, &bank));
+    return bank;
+}
 } // namespace
 
 void jt::checkResult(FMOD_RESULT result)
@@ -33,13 +49,8 @@ jt::AudioImpl::AudioImpl()
     checkResult(FMOD::Studio::System::create(&m_studioSystem));
     checkResult(m_studioSystem->initialize(128, getStudioInitFlags(), FMOD_INIT_NORMAL, nullptr));
 
-    FMOD::Studio::Bank* stringBank;
-    checkResult(m_studioSystem->loadBankFile(
-        "assets/Master.strings.bank", FMOD_STUDIO_LOAD_BANK_NORMAL, &stringBank));
-
-    FMOD::Studio::Bank* masterBank;
-    checkResult(m_studioSystem->loadBankFile(
-        "assets/Master.bank", FMOD_STUDIO_LOAD_BANK_NORMAL, &masterBank));
+    loadBank(m_studioSystem, "assets/Master.strings.bank");
+    loadBank(m_studioSystem, "assets/Master.bank");
 
     if (m_studioSystem == nullptr)
         throw std::logic_error { "FMOD studio system was not properly instantiated" };
@@ -86,8 +97,9 @@ std::shared_ptr<jt::SoundInterface> jt::AudioImpl::addPermanentSound(
 
 std::shared_ptr<jt::SoundInterface> jt::AudioImpl::getPermanentSound(std::string const& identifier)
 {
-    if (permanentSounds.contains(identifier))
-        return std::make_shared<jt::Sound>(permanentSounds[identifier]);
+    auto const it = permanentSounds.find(identifier);
+    if (it != permanentSounds.cend())
+        return std::make_shared<jt::Sound>(it->second);
 
     return nullptr;
 }
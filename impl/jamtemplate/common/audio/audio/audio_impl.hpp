@@ -4,6 +4,7 @@
 #include <audio/audio/audio_interface.hpp>
 #include <fmod.hpp>
 #include <fmod_studio.hpp>
+#include <string_id.hpp>
 #include <map>
 #include <vector>
 
@@ -32,7 +33,7 @@ public:
 private:
     FMOD::Studio::System* m_studioSystem { nullptr };
 
-    std::map<std::string, FMOD::Studio::EventInstance*> permanentSounds;
+    std::map<jt::StringId, FMOD::Studio::EventInstance*> permanentSounds;
 };
 } // namespace jt
 
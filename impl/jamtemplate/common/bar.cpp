@@ -30,18 +30,26 @@ jt::Bar::Bar(
 
 void jt::Bar::setFrontColor(jt::Color const& col) { m_shapeProgress->setColor(col); }
 
-void jt::Bar::setBackColor(jt::Color const& col) { m_shapeFull->setColor(col); }
+void jt::Bar::setBackColor(jt::Color const& col)
+{
+    m_shapeFull->setColor(col);
+    markContentChanged();
+}
 
 jt::Color jt::Bar::getBackColor() const { return m_shapeFull->getColor(); }
 
 void jt::Bar::setCurrentValue(float value)
 {
+    auto const oldValue = m_valueCurrent;
     m_valueCurrent = value;
     if (m_valueCurrent < 0) {
         m_valueCurrent = 0;
     } else if (m_valueCurrent > m_valueMax) {
         m_valueCurrent = m_valueMax;
     }
+    if (m_valueCurrent != oldValue) {
+        markContentChanged();
+    }
 }
 
 float jt::Bar::getCurrentValue() const { return m_valueCurrent; }
@@ -51,7 +59,10 @@ void jt::Bar::setMaxValue(float max)
     if (max < 0) {
         throw std::invalid_argument { "max value can not be negative" };
     }
-    m_valueMax = max;
+    if (m_valueMax != max) {
+        m_valueMax = max;
+        markContentChanged();
+    }
 }
 
 float jt::Bar::getMaxValue() const { return m_valueMax; }
@@ -7,7 +7,7 @@ std::size_t jt::Box2DContactManager::size() const { return m_callbacks.size(); }
 void jt::Box2DContactManager::registerCallback(
     std::string const& callbackIdentifier, std::shared_ptr<Box2DContactCallbackInterface> callback)
 {
-    m_callbacks[callbackIdentifier] = callback;
+    m_callbacks[callbackIdentifier] = RegisteredCallback { callbackIdentifier, callback };
 }
 
 void jt::Box2DContactManager::unregisterCallback(std::string const& callbackIdentifier)
@@ -18,9 +18,9 @@ void jt::Box2DContactManager::unregisterCallback(std::string const& callbackIden
 void jt::Box2DContactManager::BeginContact(b2Contact* contact)
 {
     for (auto const& kvp : m_callbacks) {
-        if (kvp.second) [[likely]] {
-            if (kvp.second->getEnabled()) {
-                kvp.second->onBeginContact(contact);
+        if (kvp.second.callback) [[likely]] {
+            if (kvp.second.callback->getEnabled()) {
+                kvp.second.callback->onBeginContact(contact);
             }
         }
     }
@@ -29,9 +29,9 @@ void jt::Box2DContactManager::BeginContact(b2Contact* contact)
 void jt::Box2DContactManager::EndContact(b2Contact* contact)
 {
     for (auto const& kvp : m_callbacks) {
-        if (kvp.second) [[likely]] {
-            if (kvp.second->getEnabled()) {
-                kvp.second->onEndContact(contact);
+        if (kvp.second.callback) [[likely]] {
+            if (kvp.second.callback->getEnabled()) {
+                kvp.second.callback->onEndContact(contact);
             }
         }
     }
@@ -41,6 +41,8 @@ std::vector<std::string> jt::Box2DContactManager::getAllCallbackIdentifiers() co
 {
     std::vector<std::string> identifiers;
     std::transform(m_callbacks.begin(), m_callbacks.end(), std::back_inserter(identifiers),
-        [](auto kvp) { return kvp.first; });
+        [](auto const& kvp) { return kvp.second.identifier; });
+    // callbacks are ordered by hash, identifiers are returned in alphabetical order
+    std::sort(identifiers.begin(), identifiers.end());
     return identifiers;
 }
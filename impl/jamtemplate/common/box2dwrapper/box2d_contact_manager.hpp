@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_BOX2D_CONTACT_MANAGER_HPP
 
 #include <box2dwrapper/box2d_contact_manager_interface.hpp>
+#include <string_id.hpp>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -28,7 +29,11 @@ public:
     void EndContact(b2Contact* contact) override;
 
 private:
-    std::map<std::string, std::shared_ptr<Box2DContactCallbackInterface>> m_callbacks;
+    struct RegisteredCallback {
+        std::string identifier { "" };
+        std::shared_ptr<Box2DContactCallbackInterface> callback { nullptr };
+    };
+    std::map<jt::StringId, RegisteredCallback> m_callbacks;
 };
 } // namespace jt
 #endif // JAMTEMPLATE_BOX2D_CONTACT_MANAGER_HPP
@@ -52,7 +52,14 @@ bool jt::Button::isMouseOver()
     return isOver(getGame()->input().mouse()->getMousePositionScreen());
 }
 
-void jt::Button::setVisible(bool isVisible) noexcept { m_isVisible = isVisible; }
+void jt::Button::setVisible(bool isVisible) noexcept
+{
+    if (m_isVisible != isVisible) {
+        m_isVisible = isVisible;
+        // the cached z layer needs to be redrawn to show or hide the button
+        m_background->markContentChanged();
+    }
+}
 
 bool jt::Button::getVisible() const noexcept { return m_isVisible; }
 
@@ -131,7 +138,14 @@ void jt::Button::doUpdate(float elapsed)
 
 bool jt::Button::getActive() const { return m_isActive; }
 
-void jt::Button::setActive(bool isActive) { m_isActive = isActive; }
+void jt::Button::setActive(bool isActive)
+{
+    if (m_isActive != isActive) {
+        m_isActive = isActive;
+        m_disabledOverlay->markContentChanged();
+        m_background->markContentChanged();
+    }
+}
 
 std::shared_ptr<jt::DrawableInterface> jt::Button::getBackground() { return m_background; }
 
@@ -0,0 +1,21 @@
+#include "asset_registry.hpp"
+
+std::size_t jt::AssetRegistry::evictUnused()
+{
+    std::scoped_lock const lock { m_mutex };
+    std::size_t evicted { 0u };
+    for (auto& kvp : m_stores) {
+        evicted += kvp.second->evictUnused();
+    }
+    return evicted;
+}
+
+std::size_t jt::AssetRegistry::getMemoryUsage() const
+{
+    std::scoped_lock const lock { m_mutex };
+    std::size_t memoryUsage { 0u };
+    for (auto const& kvp : m_stores) {
+        memoryUsage += kvp.second->memoryUsage;
+    }
+    return memoryUsage;
+}
@@ -0,0 +1,218 @@
+#ifndef JAMTEMPLATE_ASSET_REGISTRY_HPP
+#define JAMTEMPLATE_ASSET_REGISTRY_HPP
+
+#include <string_id.hpp>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace jt {
+
+/// Cache for assets of any type, e.g. parsed json documents or animation data. Every asset type
+/// needs a registered loader. Assets are handed out as shared pointers, so an asset stays valid
+/// for its users even if it is evicted from the registry. Thread safe, assets can be loaded from
+/// multiple threads in parallel. There is no memory budget, assets are kept until they are evicted
+/// via evict() or evictUnused().
+class AssetRegistry {
+public:
+    /// Loads an asset from its identifier, usually a file name
+    template <typename T>
+    using LoaderType = std::function<std::shared_ptr<T const>(std::string const& identifier)>;
+
+    /// Estimates the memory of an asset in bytes
+    template <typename T>
+    using SizeFunctionType = std::function<std::size_t(T const& asset)>;
+
+    /// Register the loader for an asset type. Needs to be called before assets of this type are
+    /// requested, assets of this type loaded before are dropped.
+    /// \param loader function to load an asset, throws or returns nullptr if loading failed
+    /// \param sizeFunction optional function to estimate the memory of an asset
+    template <typename T>
+    void registerLoader(LoaderType<T> loader, SizeFunctionType<T> sizeFunction = {})
+    {
+        auto store = std::make_unique<Store<T>>();
+        store->loader = std::move(loader);
+        store->sizeFunction = std::move(sizeFunction);
+        std::scoped_lock const lock { m_mutex };
+        m_stores[typeid(T)] = std::move(store);
+    }
+
+    /// Check if a loader for an asset type is registered
+    /// \return true if assets of this type can be loaded
+    template <typename T>
+    bool hasLoader() const
+    {
+        std::scoped_lock const lock { m_mutex };
+        return m_stores.contains(typeid(T));
+    }
+
+    /// Get an asset, load it if it is not cached yet
+    /// \param identifier asset identifier, usually a file name
+    /// \return the asset, shared with all other users of it
+    template <typename T>
+    std::shared_ptr<T const> get(std::string const& identifier)
+    {
+        jt::StringId const id { identifier };
+        LoaderType<T> loader {};
+        SizeFunctionType<T> sizeFunction {};
+        {
+            std::scoped_lock const lock { m_mutex };
+            auto const& store = getStore<T>();
+            if (auto const it = store.assets.find(id); it != store.assets.cend()) [[likely]] {
+                return it->second.asset;
+            }
+            // copied, registerLoader() may replace the store while the asset is loaded
+            loader = store.loader;
+            sizeFunction = store.sizeFunction;
+        }
+
+        // load without holding the lock, so different assets can be loaded in parallel
+        auto asset = loader(identifier);
+        if (!asset) {
+            throw std::invalid_argument { "asset '" + identifier + "' could not be loaded" };
+        }
+        auto const bytes = sizeFunction ? sizeFunction(*asset) : 0u;
+
+        std::scoped_lock const lock { m_mutex };
+        auto& store = getStore<T>();
+        // if another thread loaded the same asset in the meantime, its asset is kept
+        auto const [it, inserted] = store.assets.try_emplace(id, Entry<T> { asset, bytes });
+        if (inserted) {
+            store.memoryUsage += bytes;
+        }
+        return it->second.asset;
+    }
+
+    /// Load an asset into the cache without using it yet, e.g. while a loading screen is shown
+    /// \param identifier asset identifier, usually a file name
+    template <typename T>
+    void warm(std::string const& identifier)
+    {
+        get<T>(identifier);
+    }
+
+    /// Check if an asset is cached
+    /// \param identifier asset identifier, usually a file name
+    /// \return true if the asset is cached
+    template <typename T>
+    bool isCached(std::string const& identifier) const
+    {
+        std::scoped_lock const lock { m_mutex };
+        auto const it = m_stores.find(typeid(T));
+        return it != m_stores.cend()
+            && static_cast<Store<T> const&>(*it->second).assets.contains(identifier);
+    }
+
+    /// Remove an asset from the cache. Users of the asset keep their shared pointer.
+    /// \param identifier asset identifier, usually a file name
+    template <typename T>
+    void evict(std::string const& identifier)
+    {
+        std::scoped_lock const lock { m_mutex };
+        auto& store = getStore<T>();
+        auto const it = store.assets.find(identifier);
+        if (it == store.assets.end()) {
+            return;
+        }
+        store.memoryUsage -= it->second.bytes;
+        store.assets.erase(it);
+    }
+
+    /// Remove all assets of a type which are not used outside of the cache
+    /// \return number of removed assets
+    template <typename T>
+    std::size_t evictUnused()
+    {
+        std::scoped_lock const lock { m_mutex };
+        return getStore<T>().evictUnused();
+    }
+
+    /// Remove all assets of all types which are not used outside of the cache
+    /// \return number of removed assets
+    std::size_t evictUnused();
+
+    /// Get the estimated memory of all cached assets of a type
+    /// \return memory in bytes
+    template <typename T>
+    std::size_t getMemoryUsage() const
+    {
+        std::scoped_lock const lock { m_mutex };
+        auto const it = m_stores.find(typeid(T));
+        return it == m_stores.cend() ? 0u : it->second->memoryUsage;
+    }
+
+    /// Get the estimated memory of all cached assets
+    /// \return memory in bytes
+    std::size_t getMemoryUsage() const;
+
+    /// Get the number of cached assets of a type
+    /// \return number of assets
+    template <typename T>
+    std::size_t getNumberOfAssets() const
+    {
+        std::scoped_lock const lock { m_mutex };
+        auto const it = m_stores.find(typeid(T));
+        return it == m_stores.cend() ? 0u : it->second->size();
+    }
+
+private:
+    struct StoreBase {
+        virtual ~StoreBase() = default;
+        virtual std::size_t evictUnused() = 0;
+        virtual std::size_t size() const = 0;
+
+        std::size_t memoryUsage { 0u };
+    };
+
+    template <typename T>
+    struct Entry {
+        std::shared_ptr<T const> asset { nullptr };
+        std::size_t bytes { 0u };
+    };
+
+    template <typename T>
+    struct Store : StoreBase {
+        LoaderType<T> loader {};
+        SizeFunctionType<T> sizeFunction {};
+        std::map<jt::StringId, Entry<T>> assets {};
+
+        std::size_t evictUnused() override
+        {
+            return std::erase_if(assets, [this](auto const& kvp) {
+                if (kvp.second.asset.use_count() != 1) {
+                    return false;
+                }
+                memoryUsage -= kvp.second.bytes;
+                return true;
+            });
+        }
+
+        std::size_t size() const override { return assets.size(); }
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<std::type_index, std::unique_ptr<StoreBase>> m_stores {};
+
+    // m_mutex needs to be locked while the store is used
+    template <typename T>
+    Store<T>& getStore()
+    {
+        auto const it = m_stores.find(typeid(T));
+        if (it == m_stores.end()) [[unlikely]] {
+            throw std::logic_error { std::string { "no loader registered for asset type " }
+                + typeid(T).name() };
+        }
+        return static_cast<Store<T>&>(*it->second);
+    }
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASSET_REGISTRY_HPP
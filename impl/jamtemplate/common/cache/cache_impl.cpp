@@ -1,11 +1,41 @@
 #include "cache_impl.hpp"
+#include <animation_data.hpp>
+#include <aseprite_cache.hpp>
+#include <asset_pack/virtual_file_system.hpp>
+#include <cache/font_cache.hpp>
 #include <log/log_history.hpp>
 #include <tilemap/tilemap_cache.hpp>
+#include <nlohmann.hpp>
+#include <stdexcept>
+
+namespace {
+
+// walks the document instead of serializing it: one json value per node plus the string data
+std::size_t estimateJsonSize(nlohmann::json const& json)
+{
+    std::size_t bytes { sizeof(nlohmann::json) };
+    if (json.is_string()) {
+        bytes += json.get_ref<std::string const&>().size();
+    } else if (json.is_object()) {
+        for (auto const& item : json.items()) {
+            bytes += item.key().size() + estimateJsonSize(item.value());
+        }
+    } else if (json.is_array()) {
+        for (auto const& value : json) {
+            bytes += estimateJsonSize(value);
+        }
+    }
+    return bytes;
+}
+
+} // namespace
 
 jt::CacheImpl::CacheImpl(std::unique_ptr<jt::TilemapCacheInterface> tilemapCache,
-    std::shared_ptr<jt::LogHistoryInterface> logHistory)
+    std::shared_ptr<jt::LogHistoryInterface> logHistory,
+    std::unique_ptr<jt::FontCacheInterface> fontCache)
     : m_tilemapCache { std::move(tilemapCache) }
     , m_logHistory { logHistory }
+    , m_fontCache { std::move(fontCache) }
 {
     if (m_tilemapCache == nullptr) {
         m_tilemapCache = std::make_unique<jt::TilemapCache>();
@@ -13,7 +43,51 @@ jt::CacheImpl::CacheImpl(std::unique_ptr<jt::TilemapCacheInterface> tilemapCache
     if (m_logHistory == nullptr) {
         m_logHistory = std::make_shared<jt::LogHistory>();
     }
+    if (m_fontCache == nullptr) {
+        m_fontCache = std::make_unique<jt::FontCache>();
+    }
+    registerDefaultLoaders();
 }
 
 jt::TilemapCacheInterface& jt::CacheImpl::getTilemapCache() { return *m_tilemapCache; }
+jt::FontCacheInterface& jt::CacheImpl::getFontCache() { return *m_fontCache; }
 std::shared_ptr<jt::LogHistoryInterface> jt::CacheImpl::getLogHistory() { return m_logHistory; }
+jt::AssetRegistry& jt::CacheImpl::getAssetRegistry() { return m_assetRegistry; }
+
+void jt::CacheImpl::registerDefaultLoaders()
+{
+    m_assetRegistry.registerLoader<jt::DecodedAseprite>(
+        [](std::string const& fileName) {
+            return std::make_shared<jt::DecodedAseprite const>(jt::AsepriteCache::load(fileName));
+        },
+        [](jt::DecodedAseprite const& ase) {
+            return ase.pixels.size() + ase.frameDurations.size() * sizeof(float);
+        });
+
+    m_assetRegistry.registerLoader<jt::AnimationData>(
+        [](std::string const& fileName) {
+            return fileName.ends_with(".json")
+                ? jt::AnimationDataLoader::createFromJson(fileName)
+                : jt::AnimationDataLoader::createFromAseprite(fileName);
+        },
+        [](jt::AnimationData const& data) {
+            std::size_t bytes { 0u };
+            for (auto const& kvp : data.clips) {
+                bytes += kvp.second.frameRects.size() * sizeof(jt::Recti)
+                    + kvp.second.frameTimes.size() * sizeof(float);
+            }
+            return bytes;
+        });
+
+    m_assetRegistry.registerLoader<nlohmann::json>(
+        [](std::string const& fileName) {
+            return std::make_shared<nlohmann::json const>(
+                nlohmann::json::parse(jt::VirtualFileSystem::readFile(fileName)));
+        },
+        [](nlohmann::json const& json) { return estimateJsonSize(json); });
+
+    // maps are shared with the tilemap cache, which keeps them alive
+    m_assetRegistry.registerLoader<tson::Map>([this](std::string const& fileName) {
+        return std::shared_ptr<tson::Map const> { m_tilemapCache->get(fileName) };
+    });
+}
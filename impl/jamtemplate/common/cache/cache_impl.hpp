@@ -7,14 +7,21 @@ namespace jt {
 class CacheImpl : public jt::CacheInterface {
 public:
     CacheImpl(std::unique_ptr<jt::TilemapCacheInterface> tilemapCache = nullptr,
-        std::shared_ptr<jt::LogHistoryInterface> logHistory = nullptr);
+        std::shared_ptr<jt::LogHistoryInterface> logHistory = nullptr,
+        std::unique_ptr<jt::FontCacheInterface> fontCache = nullptr);
 
     jt::TilemapCacheInterface& getTilemapCache() override;
+    jt::FontCacheInterface& getFontCache() override;
     std::shared_ptr<jt::LogHistoryInterface> getLogHistory() override;
+    jt::AssetRegistry& getAssetRegistry() override;
 
 private:
     std::unique_ptr<jt::TilemapCacheInterface> m_tilemapCache { nullptr };
     std::shared_ptr<jt::LogHistoryInterface> m_logHistory { nullptr };
+    std::unique_ptr<jt::FontCacheInterface> m_fontCache { nullptr };
+    jt::AssetRegistry m_assetRegistry {};
+
+    void registerDefaultLoaders();
 };
 
 } // namespace jt
@@ -1,6 +1,8 @@
 #ifndef JAMTEMPLATE_CACHE_INTERFACE_HPP
 #define JAMTEMPLATE_CACHE_INTERFACE_HPP
 
+#include <cache/asset_registry.hpp>
+#include <cache/font_cache_interface.hpp>
 #include <log/log_history_interface.hpp>
 #include <tilemap/tilemap_cache_interface.hpp>
 
@@ -11,10 +13,19 @@ public:
     /// \return the tilemap cache
     virtual jt::TilemapCacheInterface& getTilemapCache() = 0;
 
+    /// Get the font cache
+    /// \return the font cache
+    virtual jt::FontCacheInterface& getFontCache() = 0;
+
     /// Get the log history
     /// \return the log history
     virtual std::shared_ptr<jt::LogHistoryInterface> getLogHistory() = 0;
 
+    /// Get the asset registry, which caches assets of any type with a registered loader, e.g.
+    /// jt::AnimationData, jt::DecodedAseprite, nlohmann::json or tson::Map
+    /// \return the asset registry
+    virtual jt::AssetRegistry& getAssetRegistry() = 0;
+
     /// Destructor
     virtual ~CacheInterface() = default;
 
@@ -1,7 +1,15 @@
 #include "cache_null.hpp"
 
-jt::CacheNull::CacheNull() { m_tilemapCache = std::make_unique<jt::TilemapCacheNull>(); }
+jt::CacheNull::CacheNull()
+{
+    m_tilemapCache = std::make_unique<jt::TilemapCacheNull>();
+    m_fontCache = std::make_unique<jt::FontCacheNull>();
+}
 
 jt::TilemapCacheInterface& jt::CacheNull::getTilemapCache() noexcept { return *m_tilemapCache; }
 
+jt::FontCacheInterface& jt::CacheNull::getFontCache() noexcept { return *m_fontCache; }
+
 std::shared_ptr<jt::LogHistoryInterface> jt::CacheNull::getLogHistory() noexcept { return m_history; }
+
+jt::AssetRegistry& jt::CacheNull::getAssetRegistry() noexcept { return m_assetRegistry; }
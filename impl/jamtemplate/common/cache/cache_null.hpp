@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_CACHE_NULL_HPP
 
 #include <cache/cache_interface.hpp>
+#include <cache/font_cache_null.hpp>
 #include <log/log_history_null.hpp>
 #include <tilemap/tilemap_cache_null.hpp>
 #include <memory>
@@ -12,12 +13,18 @@ class CacheNull : public jt::CacheInterface {
 public:
     CacheNull();
     jt::TilemapCacheInterface& getTilemapCache() noexcept override;
+    jt::FontCacheInterface& getFontCache() noexcept override;
 
     std::shared_ptr<jt::LogHistoryInterface> getLogHistory() noexcept override;
 
+    /// no loaders are registered, so no assets can be loaded
+    jt::AssetRegistry& getAssetRegistry() noexcept override;
+
 private:
     std::unique_ptr<jt::TilemapCacheNull> m_tilemapCache { nullptr };
+    std::unique_ptr<jt::FontCacheNull> m_fontCache { nullptr };
     std::shared_ptr<jt::null_objects::LogHistoryNull> m_history { nullptr };
+    jt::AssetRegistry m_assetRegistry {};
 };
 } // namespace jt
 #endif // JAMTEMPLATE_CACHE_NULL_HPP
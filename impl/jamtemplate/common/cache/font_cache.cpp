@@ -0,0 +1,34 @@
+#include "font_cache.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+
+std::shared_ptr<jt::FontLib> jt::FontCache::get(std::string const& fontFileName,
+    unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    ZoneScopedN("jt::FontCache::get");
+#if USE_SFML
+    // sf::Font renders all character sizes, so one font is shared by texts of all sizes
+    auto const key = std::make_pair(fontFileName, 0u);
+#else
+    auto const key = std::make_pair(fontFileName, characterSize);
+#endif
+    if (auto const it = m_fonts.find(key); it != m_fonts.end()) [[likely]] {
+        if (auto font = it->second.lock()) [[likely]] {
+            return font;
+        }
+    }
+
+    auto font = jt::loadFontLib(fontFileName, characterSize, renderTarget);
+    // drop fonts no text uses anymore, so the map does not grow with every font ever loaded
+    std::erase_if(m_fonts, [](auto const& kvp) { return kvp.second.expired(); });
+    if (font) {
+        m_fonts[key] = font;
+    }
+    return font;
+}
+
+std::size_t jt::FontCache::getNumberOfFonts() const
+{
+    return static_cast<std::size_t>(std::count_if(
+        m_fonts.cbegin(), m_fonts.cend(), [](auto const& kvp) { return !kvp.second.expired(); }));
+}
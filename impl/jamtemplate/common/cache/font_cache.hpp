@@ -0,0 +1,28 @@
+#ifndef JAMTEMPLATE_FONT_CACHE_HPP
+#define JAMTEMPLATE_FONT_CACHE_HPP
+
+#include <cache/font_cache_interface.hpp>
+#include <map>
+#include <utility>
+
+namespace jt {
+
+/// Font cache that keeps a font alive as long as one user of it exists. Fonts are not kept
+/// beyond that, so no font resources outlive the render target they have been created for. SDL
+/// fonts are cached per character size, SFML fonts are shared by all character sizes.
+class FontCache : public jt::FontCacheInterface {
+public:
+    std::shared_ptr<jt::FontLib> get(std::string const& fontFileName, unsigned int characterSize,
+        std::shared_ptr<jt::RenderTargetLayer> renderTarget) override;
+
+    /// Get the number of fonts that are currently in use
+    /// \return number of fonts
+    std::size_t getNumberOfFonts() const;
+
+private:
+    std::map<std::pair<std::string, unsigned int>, std::weak_ptr<jt::FontLib>> m_fonts;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_FONT_CACHE_HPP
@@ -0,0 +1,38 @@
+#ifndef JAMTEMPLATE_FONT_CACHE_INTERFACE_HPP
+#define JAMTEMPLATE_FONT_CACHE_INTERFACE_HPP
+
+#include <font_lib.hpp>
+#include <render_target_layer.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+class FontCacheInterface {
+public:
+    /// Get a font for a filename and character size. This function is expected to share the
+    /// opened font between all callers requesting the same file and size.
+    /// \param fontFileName path to the font (ttf)
+    /// \param characterSize character size
+    /// \param renderTarget the render target (unused for sfml, but needed for sdl compatibility)
+    /// \return the font, nullptr if the font could not be loaded
+    virtual std::shared_ptr<jt::FontLib> get(std::string const& fontFileName,
+        unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget) = 0;
+
+    /// Destructor
+    virtual ~FontCacheInterface() = default;
+
+    // no copy, no move. Avoid slicing.
+    FontCacheInterface(FontCacheInterface const&) = delete;
+    FontCacheInterface(FontCacheInterface&&) = delete;
+    FontCacheInterface& operator=(FontCacheInterface const&) = delete;
+    FontCacheInterface& operator=(FontCacheInterface&&) = delete;
+
+protected:
+    // default constructor can only be called from derived classes
+    FontCacheInterface() = default;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_FONT_CACHE_INTERFACE_HPP
@@ -0,0 +1,7 @@
+#include "font_cache_null.hpp"
+
+std::shared_ptr<jt::FontLib> jt::FontCacheNull::get(std::string const& fontFileName,
+    unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    return jt::loadFontLib(fontFileName, characterSize, renderTarget);
+}
@@ -0,0 +1,17 @@
+#ifndef JAMTEMPLATE_FONT_CACHE_NULL_HPP
+#define JAMTEMPLATE_FONT_CACHE_NULL_HPP
+
+#include <cache/font_cache_interface.hpp>
+
+namespace jt {
+
+/// Font cache that does not cache, every call opens the font again.
+class FontCacheNull : public jt::FontCacheInterface {
+public:
+    std::shared_ptr<jt::FontLib> get(std::string const& fontFileName, unsigned int characterSize,
+        std::shared_ptr<jt::RenderTargetLayer> renderTarget) override;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_FONT_CACHE_NULL_HPP
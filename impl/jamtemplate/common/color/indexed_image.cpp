@@ -0,0 +1,81 @@
+#include "indexed_image.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+constexpr std::size_t maxNumberOfColors { 256u };
+
+std::uint32_t toPixel(jt::Color const& color) noexcept
+{
+    std::array<std::uint8_t, 4> const rgba { color.r, color.g, color.b, color.a };
+    std::uint32_t pixel { 0u };
+    std::memcpy(&pixel, rgba.data(), sizeof(pixel));
+    return pixel;
+}
+
+} // namespace
+
+jt::IndexedImage::IndexedImage(unsigned int width, unsigned int height, std::uint8_t const* rgba)
+    : m_width { width }
+    , m_height { height }
+{
+    auto const numberOfPixels = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    m_indices.resize(numberOfPixels);
+
+    std::vector<jt::Color> colors {};
+    std::unordered_map<std::uint32_t, std::uint8_t> indexOfPixel {};
+    // pixel art has long runs of the same color, which do not need a lookup
+    std::uint32_t lastPixel { 0u };
+    std::uint8_t lastIndex { 0u };
+    for (std::size_t i = 0u; i != numberOfPixels; ++i) {
+        std::uint32_t pixel { 0u };
+        std::memcpy(&pixel, rgba + i * 4u, sizeof(pixel));
+        if (pixel == lastPixel && !colors.empty()) [[likely]] {
+            m_indices[i] = lastIndex;
+            continue;
+        }
+
+        auto const [it, inserted]
+            = indexOfPixel.try_emplace(pixel, static_cast<std::uint8_t>(colors.size()));
+        if (inserted) {
+            if (colors.size() == maxNumberOfColors) [[unlikely]] {
+                throw std::invalid_argument { "image has more than 256 colors" };
+            }
+            auto const* const c = rgba + i * 4u;
+            colors.push_back(jt::Color { c[0], c[1], c[2], c[3] });
+        }
+        lastPixel = pixel;
+        lastIndex = it->second;
+        m_indices[i] = lastIndex;
+    }
+    m_palette = jt::Palette { colors };
+}
+
+unsigned int jt::IndexedImage::getWidth() const noexcept { return m_width; }
+
+unsigned int jt::IndexedImage::getHeight() const noexcept { return m_height; }
+
+std::vector<std::uint8_t> const& jt::IndexedImage::getIndices() const noexcept
+{
+    return m_indices;
+}
+
+jt::Palette const& jt::IndexedImage::getPalette() const noexcept { return m_palette; }
+
+std::vector<std::uint8_t> jt::IndexedImage::toRGBA(jt::Palette const& palette) const
+{
+    // lookup table for all possible indices, so converting a pixel is a single copy
+    std::array<std::uint32_t, maxNumberOfColors> lookup {};
+    for (std::size_t i = 0u; i != m_palette.size(); ++i) {
+        lookup[i] = toPixel(i < palette.size() ? palette.getColor(i) : m_palette.getColor(i));
+    }
+
+    std::vector<std::uint8_t> rgba(m_indices.size() * 4u);
+    for (std::size_t i = 0u; i != m_indices.size(); ++i) {
+        std::memcpy(rgba.data() + i * 4u, &lookup[m_indices[i]], sizeof(std::uint32_t));
+    }
+    return rgba;
+}
@@ -0,0 +1,53 @@
+#ifndef JAMTEMPLATE_INDEXED_IMAGE_HPP
+#define JAMTEMPLATE_INDEXED_IMAGE_HPP
+
+#include <color/palette.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace jt {
+
+/// Image which stores one palette index per pixel instead of rgba values. Recolored variants of an
+/// image share the indices and only differ in the palette, which takes a quarter of the memory
+/// of rgba values.
+class IndexedImage {
+public:
+    /// Create an indexed image from rgba values. Colors are indexed in the order in which they
+    /// appear first. Will raise an exception if the image contains more than 256 colors.
+    /// \param width width in pixel
+    /// \param height height in pixel
+    /// \param rgba rgba values row by row, needs to hold 4 * width * height values
+    IndexedImage(unsigned int width, unsigned int height, std::uint8_t const* rgba);
+
+    /// Get the width of the image
+    /// \return width in pixel
+    unsigned int getWidth() const noexcept;
+
+    /// Get the height of the image
+    /// \return height in pixel
+    unsigned int getHeight() const noexcept;
+
+    /// Get the palette indices of all pixels
+    /// \return indices row by row
+    std::vector<std::uint8_t> const& getIndices() const noexcept;
+
+    /// Get the colors of the image
+    /// \return the palette, indexed by the values of getIndices()
+    jt::Palette const& getPalette() const noexcept;
+
+    /// Convert the image to rgba values using a palette lookup
+    /// \param palette colors for the indices, e.g. a swapped version of getPalette(). Indices
+    ///        which are not contained in the palette use the original color.
+    /// \return rgba values row by row
+    std::vector<std::uint8_t> toRGBA(jt::Palette const& palette) const;
+
+private:
+    unsigned int m_width { 0u };
+    unsigned int m_height { 0u };
+    std::vector<std::uint8_t> m_indices {};
+    jt::Palette m_palette {};
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_INDEXED_IMAGE_HPP
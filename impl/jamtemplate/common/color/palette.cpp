@@ -1,5 +1,8 @@
 #include "palette.hpp"
 #include <strutils.hpp>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 jt::Palette::Palette(std::vector<jt::Color> const& colors)
     : m_colors { colors }
@@ -11,3 +14,26 @@ std::size_t jt::Palette::size() const noexcept { return m_colors.size(); }
 bool jt::Palette::empty() const noexcept { return m_colors.empty(); }
 
 jt::Color const& jt::Palette::getColor(std::size_t const idx) const { return m_colors.at(idx); }
+
+std::optional<std::size_t> jt::Palette::find(jt::Color const& color) const noexcept
+{
+    auto const it = std::find(m_colors.cbegin(), m_colors.cend(), color);
+    if (it == m_colors.cend()) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(std::distance(m_colors.cbegin(), it));
+}
+
+jt::Palette jt::Palette::swapped(jt::Palette const& source, jt::Palette const& target) const
+{
+    if (source.size() != target.size()) {
+        throw std::invalid_argument { "source and target palette need to have the same size" };
+    }
+    auto colors = m_colors;
+    for (auto& color : colors) {
+        if (auto const idx = source.find(color)) {
+            color = target.getColor(*idx);
+        }
+    }
+    return jt::Palette { colors };
+}
@@ -3,6 +3,7 @@
 
 #include <color/color.hpp>
 #include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace jt {
@@ -30,6 +31,18 @@ public:
     /// \return the Color
     jt::Color const& getColor(std::size_t idx) const;
 
+    /// Find a color in the palette.
+    /// \param color the color to look for
+    /// \return index of the first occurrence of the color, empty optional if it is not contained
+    std::optional<std::size_t> find(jt::Color const& color) const noexcept;
+
+    /// Create a copy of this palette in which colors are replaced, e.g. to recolor a sprite.
+    /// Will raise an exception if source and target have different sizes.
+    /// \param source colors to replace
+    /// \param target replacement for the color with the same index in source
+    /// \return the palette with replaced colors, other colors are unchanged
+    jt::Palette swapped(jt::Palette const& source, jt::Palette const& target) const;
+
 private:
     std::vector<jt::Color> m_colors;
 };
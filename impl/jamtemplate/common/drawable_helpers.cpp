@@ -22,21 +22,22 @@ std::shared_ptr<jt::Shape> jt::dh::createShapeCircle(
 }
 
 std::shared_ptr<jt::Text> jt::dh::createText(std::weak_ptr<jt::RenderTargetLayer> renderTarget,
-    std::string const& text, unsigned int fontSize, jt::Color const& col,
-    std::string const& font_path)
+    jt::FontCacheInterface& fontCache, std::string const& text, unsigned int fontSize,
+    jt::Color const& col, std::string const& font_path)
 {
     auto ptr = std::make_shared<jt::Text>();
-    ptr->loadFont(font_path, fontSize, std::move(renderTarget));
+    ptr->loadFont(font_path, fontSize, std::move(renderTarget), fontCache);
     ptr->setText(text);
     ptr->setColor(col);
     return ptr;
 }
 
 std::shared_ptr<jt::Text> jt::dh::createText(
-    std::shared_ptr<jt::RenderTargetInterface> renderTarget, std::string const& text,
-    unsigned int fontSize, jt::Color const& col, std::string const& font_path)
+    std::shared_ptr<jt::RenderTargetInterface> renderTarget, jt::FontCacheInterface& fontCache,
+    std::string const& text, unsigned int fontSize, jt::Color const& col,
+    std::string const& font_path)
 {
-    return createText(renderTarget->get(0), text, fontSize, col, font_path);
+    return createText(renderTarget->get(0), fontCache, text, fontSize, col, font_path);
 }
 
 std::shared_ptr<jt::Sprite> jt::dh::createVignette(
@@ -13,6 +13,7 @@ namespace jt {
 // fwd declarations
 class Shape;
 class Text;
+class FontCacheInterface;
 
 namespace dh {
 
@@ -28,18 +29,19 @@ std::shared_ptr<jt::Shape> createShapeCircle(
 
 /// Create a text
 /// \param renderTarget weak pointer to rendertarget
+/// \param fontCache the font cache, texts with the same font and size share the font
 /// \param text the string displayed in the text
 /// \param fontSize how big are the letters in the text
 /// \param col the color of the text
 /// \param font_path path to the ttf file (e.g. "assets/font.ttf")
 /// \return shared pointer to text
 std::shared_ptr<jt::Text> createText(std::weak_ptr<jt::RenderTargetLayer> renderTarget,
-    std::string const& text, unsigned int fontSize, jt::Color const& col = jt::colors::White,
-    std::string const& font_path = "assets/font.ttf");
+    jt::FontCacheInterface& fontCache, std::string const& text, unsigned int fontSize,
+    jt::Color const& col = jt::colors::White, std::string const& font_path = "assets/font.ttf");
 
 std::shared_ptr<jt::Text> createText(std::shared_ptr<jt::RenderTargetInterface> renderTarget,
-    std::string const& text, unsigned int fontSize, jt::Color const& col = jt::colors::White,
-    std::string const& font_path = "assets/font.ttf");
+    jt::FontCacheInterface& fontCache, std::string const& text, unsigned int fontSize,
+    jt::Color const& col = jt::colors::White, std::string const& font_path = "assets/font.ttf");
 
 /// Create a vignette sprite
 /// \param size the size of the vignette
@@ -1,7 +1,27 @@
 ﻿#include "drawable_impl.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 jt::Vector2f jt::DrawableImpl::m_CamOffset { 0.0f, 0.0f };
+std::shared_ptr<jt::RenderQueue> jt::DrawableImpl::m_renderQueue { nullptr };
+jt::Vector2f jt::DrawableImpl::m_viewSize { 0.0f, 0.0f };
+std::weak_ptr<jt::RenderTargetInterface> jt::DrawableImpl::m_renderTarget {};
+std::uint64_t jt::DrawableImpl::m_camOffsetGeneration { 0u };
+
+jt::DrawableImpl::~DrawableImpl()
+{
+    if (!m_drawnIntoCachedLayer) {
+        return;
+    }
+    auto const target = m_renderTarget.lock();
+    if (target) {
+        // otherwise the pixels of a killed drawable stay in a cached z layer
+        target->invalidateLayer(m_z, m_drawnScreenBounds);
+    }
+}
 
 void jt::DrawableImpl::draw(std::shared_ptr<jt::RenderTargetInterface> targetContainer) const
 {
@@ -12,6 +32,15 @@ void jt::DrawableImpl::draw(std::shared_ptr<jt::RenderTargetInterface> targetCon
     if (!targetContainer) [[unlikely]] {
         return;
     }
+    m_drawnIntoCachedLayer = targetContainer->isLayerCached(m_z);
+    if (m_contentChanged && m_drawnIntoCachedLayer) {
+        // changed after update(), the cached z layer is redrawn in the next frame
+        invalidateLayer(*targetContainer, getScreenExtent());
+    }
+    if (!targetContainer->needsRedraw(m_z)) {
+        // z layer is cached and still shows this drawable from a previous frame
+        return;
+    }
     auto const sptr = targetContainer->get(m_z);
     if (sptr) [[likely]] {
         draw(sptr);
@@ -22,6 +51,10 @@ void jt::DrawableImpl::draw(std::shared_ptr<RenderTargetLayer> sptr) const
 {
     if (isVisible()) {
         if (allowDrawFromFlicker()) {
+            if (m_renderQueue && !usesRenderQueue()) {
+                m_renderQueue->flush();
+            }
+            refreshTransform();
             drawShadow(sptr);
             drawOutline(sptr);
             doDraw(sptr);
@@ -30,22 +63,184 @@ void jt::DrawableImpl::draw(std::shared_ptr<RenderTargetLayer> sptr) const
     }
 }
 
-void jt::DrawableImpl::flash(float t, jt::Color col) { doFlash(t, col); }
+void jt::DrawableImpl::drawInstances(std::shared_ptr<jt::RenderTargetInterface> targetContainer,
+    std::span<jt::Vector2f const> positions) const
+{
+    if (!targetContainer) [[unlikely]] {
+        return;
+    }
+    if (positions.empty()) {
+        return;
+    }
+    m_drawnIntoCachedLayer = targetContainer->isLayerCached(m_z);
+    if (m_drawnIntoCachedLayer) {
+        // instances cover the extent of all instance positions
+        auto const extent = getScreenExtent(positions);
+        if (m_contentChanged || extent != m_drawnScreenBounds) {
+            invalidateLayer(*targetContainer, extent);
+        }
+    }
+    if (!targetContainer->needsRedraw(m_z)) {
+        return;
+    }
+    auto const sptr = targetContainer->get(m_z);
+    if (sptr) [[likely]] {
+        drawInstances(sptr, positions);
+    }
+}
+
+void jt::DrawableImpl::drawInstances(
+    std::shared_ptr<jt::RenderTargetLayer> sptr, std::span<jt::Vector2f const> positions) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+    if (!allowDrawFromFlicker() || !isVisible(positions)) {
+        return;
+    }
+    if (m_renderQueue && !usesRenderQueue()) {
+        m_renderQueue->flush();
+    }
+    refreshTransform();
+    doDrawInstances(sptr, positions);
+}
+
+void jt::DrawableImpl::drawInstances(std::shared_ptr<jt::RenderTargetInterface> targetContainer,
+    std::span<jt::DrawInstance const> instances) const
+{
+    if (!targetContainer) [[unlikely]] {
+        return;
+    }
+    if (instances.empty()) {
+        return;
+    }
+    m_drawnIntoCachedLayer = targetContainer->isLayerCached(m_z);
+    if (m_drawnIntoCachedLayer) {
+        auto const extent = getScreenExtent(instances);
+        if (m_contentChanged || extent != m_drawnScreenBounds) {
+            invalidateLayer(*targetContainer, extent);
+        }
+    }
+    if (!targetContainer->needsRedraw(m_z)) {
+        return;
+    }
+    auto const sptr = targetContainer->get(m_z);
+    if (sptr) [[likely]] {
+        drawInstances(sptr, instances);
+    }
+}
+
+void jt::DrawableImpl::drawInstances(
+    std::shared_ptr<jt::RenderTargetLayer> sptr, std::span<jt::DrawInstance const> instances) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+    if (!allowDrawFromFlicker() || !isVisible(instances)) {
+        return;
+    }
+    if (m_renderQueue && !usesRenderQueue()) {
+        m_renderQueue->flush();
+    }
+    refreshTransform();
+    doDrawTransformedInstances(sptr, instances);
+}
+
+void jt::DrawableImpl::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
+{
+    // The drawable is moved to every position and drawn. The position is restored when leaving
+    // this function, also if drawing throws. Not thread safe, as the drawable is changed while the
+    // instances are drawn.
+    auto& self = const_cast<jt::DrawableImpl&>(*this);
+    struct PositionRestorer {
+        jt::DrawableImpl& drawable;
+        jt::Vector2f position;
+
+        ~PositionRestorer()
+        {
+            drawable.setPosition(position);
+            drawable.markTransformDirty();
+        }
+    } const restorer { self, getPosition() };
+
+    for (auto const& position : positions) {
+        self.setPosition(position);
+        markTransformDirty();
+        refreshTransform();
+        if (isVisible()) {
+            doDraw(sptr);
+        }
+    }
+}
+
+void jt::DrawableImpl::doDrawTransformedInstances(
+    std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/,
+    std::span<jt::DrawInstance const> /*instances*/) const
+{
+    throw std::logic_error { "drawInstances with DrawInstances is not supported by this drawable" };
+}
+
+void jt::DrawableImpl::submit(jt::RenderCommand const& command, bool queued) const
+{
+    if (m_renderQueue) [[likely]] {
+        if (queued) {
+            m_renderQueue->push(command);
+            return;
+        }
+        m_renderQueue->flush();
+    }
+    command.draw();
+}
+
+void jt::DrawableImpl::flash(float t, jt::Color col)
+{
+    doFlash(t, col);
+    markContentChanged();
+}
 
 void jt::DrawableImpl::shake(float t, float strength, float shakeInterval)
 {
     doShake(t, strength, shakeInterval);
 }
 
-void jt::DrawableImpl::flicker(float duration, float interval) { doFlicker(duration, interval); }
+void jt::DrawableImpl::flicker(float duration, float interval)
+{
+    doFlicker(duration, interval);
+    markContentChanged();
+}
 
 void jt::DrawableImpl::update(float elapsed)
 {
+    auto const oldShakeOffset = doGetShakeOffset();
     updateShake(elapsed);
+    if (oldShakeOffset != doGetShakeOffset()) {
+        markTransformDirty();
+    }
     updateFlash(elapsed);
     updateFlicker(elapsed);
     doUpdate(elapsed);
     m_hasBeenUpdated = true;
+
+    // uncached z layers are redrawn every frame anyway, so changes only need to be tracked in
+    // cached z layers. Drawables that are only drawn as part of another drawable do not have a z
+    // layer.
+    if (!m_drawnIntoCachedLayer) [[likely]] {
+        return;
+    }
+    VisibleState const visibleState { getPosition(), getScale(), m_offset, m_origin,
+        getShakeOffset(), getRotation(), getColor(), getFlashColor(), allowDrawFromFlicker() };
+    if (visibleState != m_visibleState) {
+        m_visibleState = visibleState;
+        m_contentChanged = true;
+    }
+    if (m_contentChanged) {
+        // invalidate before the frame is drawn, so cached z layers are redrawn in this frame
+        auto const target = m_renderTarget.lock();
+        if (target) {
+            invalidateLayer(*target, getScreenExtent());
+        }
+    }
 }
 
 jt::Vector2f jt::DrawableImpl::getOffset() const { return m_offset; }
@@ -54,6 +249,7 @@ void jt::DrawableImpl::setOffset(jt::Vector2f const& offset)
 {
     m_offset = offset;
     m_offsetMode = jt::OffsetMode::MANUAL;
+    markTransformDirty();
 }
 
 jt::OffsetMode jt::DrawableImpl::getOffsetMode() const { return m_offsetMode; }
@@ -66,6 +262,7 @@ void jt::DrawableImpl::setOffset(jt::OffsetMode offset)
     } else if (m_offsetMode == OffsetMode::CENTER) {
         m_offset = jt::Vector2f { -0.5f * getLocalBounds().width, -0.5f * getLocalBounds().height };
     }
+    markTransformDirty();
 }
 
 void jt::DrawableImpl::setOrigin(jt::Vector2f const& origin)
@@ -73,6 +270,7 @@ void jt::DrawableImpl::setOrigin(jt::Vector2f const& origin)
     m_origin = origin;
     m_originMode = jt::OriginMode::MANUAL;
     setOriginInternal(m_origin);
+    markTransformDirty();
 }
 
 jt::OriginMode jt::DrawableImpl::getOriginMode() const { return m_originMode; }
@@ -86,15 +284,24 @@ void jt::DrawableImpl::setOrigin(jt::OriginMode origin)
         m_origin = jt::Vector2f { 0.5f * getLocalBounds().width, 0.5f * getLocalBounds().height };
     }
     setOriginInternal(m_origin);
+    markTransformDirty();
 }
 
 jt::Vector2f jt::DrawableImpl::getOrigin() const { return m_origin; }
 
-void jt::DrawableImpl::setRotation(float rot) { doSetRotation(rot); }
+void jt::DrawableImpl::setRotation(float rot)
+{
+    doSetRotation(rot);
+    markTransformDirty();
+}
 
 float jt::DrawableImpl::getRotation() const { return doGetRotation(); }
 
-void jt::DrawableImpl::setShadowActive(bool active) { doSetShadowActive(active); }
+void jt::DrawableImpl::setShadowActive(bool active)
+{
+    doSetShadowActive(active);
+    markContentChanged();
+}
 
 bool jt::DrawableImpl::getShadowActive() const { return doGetShadowActive(); }
 
@@ -108,14 +315,20 @@ void jt::DrawableImpl::setIgnoreCamMovement(bool ignore)
     if (m_ignoreCamMovement) {
         m_camMovementFactor = 0.0f;
     }
+    markTransformDirty();
 }
 
 void jt::DrawableImpl::setShadow(jt::Color const& col, jt::Vector2f const& offset)
 {
     doSetShadow(col, offset);
+    markContentChanged();
 }
 
-void jt::DrawableImpl::setOutline(jt::Color const& col, int width) { doSetOutline(col, width); }
+void jt::DrawableImpl::setOutline(jt::Color const& col, int width)
+{
+    doSetOutline(col, width);
+    markContentChanged();
+}
 
 jt::Vector2f jt::DrawableImpl::getShakeOffset() const { return doGetShakeOffset(); }
 
@@ -133,11 +346,56 @@ jt::Vector2f jt::DrawableImpl::getCamOffset() const
 
 bool jt::DrawableImpl::getIgnoreCamMovement() const { return m_ignoreCamMovement; }
 
-void jt::DrawableImpl::setCamOffset(jt::Vector2f const& v) { m_CamOffset = v; }
+void jt::DrawableImpl::setCamOffset(jt::Vector2f const& v)
+{
+    if (m_CamOffset != v) {
+        m_CamOffset = v;
+        // invalidates the transform of all drawables at once
+        ++m_camOffsetGeneration;
+    }
+}
 
 jt::Vector2f jt::DrawableImpl::getStaticCamOffset() { return m_CamOffset; }
 
-void jt::DrawableImpl::setFlashColor(jt::Color const& col) { doSetFlashColor(col); }
+std::shared_ptr<jt::RenderQueue> const& jt::DrawableImpl::getRenderQueue()
+{
+    return m_renderQueue;
+}
+
+void jt::DrawableImpl::setRenderQueue(std::shared_ptr<jt::RenderQueue> queue)
+{
+    m_renderQueue = queue;
+}
+
+jt::Vector2f jt::DrawableImpl::getStaticViewSize() { return m_viewSize; }
+
+void jt::DrawableImpl::setStaticViewSize(jt::Vector2f const& size) { m_viewSize = size; }
+
+void jt::DrawableImpl::setStaticRenderTarget(std::weak_ptr<jt::RenderTargetInterface> target)
+{
+    m_renderTarget = target;
+}
+
+void jt::DrawableImpl::setCullingEnabled(bool enabled) { m_cullingEnabled = enabled; }
+
+bool jt::DrawableImpl::getCullingEnabled() const { return m_cullingEnabled; }
+
+jt::Vector2f jt::DrawableImpl::getCullingViewSize() const
+{
+    if (!m_cullingEnabled) {
+        return jt::Vector2f { 0.0f, 0.0f };
+    }
+    if (m_screenSizeHint.x != 0 || m_screenSizeHint.y != 0) {
+        return m_screenSizeHint;
+    }
+    return m_viewSize;
+}
+
+void jt::DrawableImpl::setFlashColor(jt::Color const& col)
+{
+    doSetFlashColor(col);
+    markContentChanged();
+}
 
 jt::Color jt::DrawableImpl::getFlashColor() const { return doGetFlashColor(); }
 
@@ -145,27 +403,121 @@ void jt::DrawableImpl::setScreenSizeHint(jt::Vector2f const& hint) { m_screenSiz
 
 bool jt::DrawableImpl::isVisible() const
 {
-    if (m_screenSizeHint.x == 0 && m_screenSizeHint.y == 0) {
+    auto const viewSize = getCullingViewSize();
+    if (viewSize.x == 0 && viewSize.y == 0) {
         return true;
     }
 
-    jt::Vector2f const camOffset = getStaticCamOffset() * m_camMovementFactor;
-    if (getPosition().x + camOffset.x + getLocalBounds().width < 0) {
+    auto const extent = getScreenExtent();
+    if (extent.left + extent.width < 0.0f || extent.top + extent.height < 0.0f) {
         return false;
     }
-    if (getPosition().y + camOffset.y + getLocalBounds().height < 0) {
+    if (extent.left >= viewSize.x || extent.top >= viewSize.y) {
         return false;
     }
-    if (getPosition().x + camOffset.x >= this->m_screenSizeHint.x + getLocalBounds().width) {
+    return true;
+}
+
+bool jt::DrawableImpl::isVisible(std::span<jt::Vector2f const> positions) const
+{
+    if (positions.empty()) {
         return false;
     }
-    if (getPosition().y + camOffset.y >= this->m_screenSizeHint.y + getLocalBounds().height) {
+    auto const viewSize = getCullingViewSize();
+    if (viewSize.x == 0 && viewSize.y == 0) {
+        return true;
+    }
+    return isOnScreen(getScreenExtent(positions), viewSize);
+}
+
+bool jt::DrawableImpl::isVisible(std::span<jt::DrawInstance const> instances) const
+{
+    if (instances.empty()) {
+        return false;
+    }
+    auto const viewSize = getCullingViewSize();
+    if (viewSize.x == 0 && viewSize.y == 0) {
+        return true;
+    }
+    return isOnScreen(getScreenExtent(instances), viewSize);
+}
+
+bool jt::DrawableImpl::isOnScreen(jt::Rectf const& extent, jt::Vector2f const& viewSize)
+{
+    if (extent.left + extent.width < 0.0f || extent.top + extent.height < 0.0f) {
+        return false;
+    }
+    if (extent.left >= viewSize.x || extent.top >= viewSize.y) {
         return false;
     }
     return true;
 }
 
-void jt::DrawableImpl::setBlendMode(jt::BlendMode mode) { m_blendMode = mode; }
+jt::Rectf jt::DrawableImpl::getScreenExtent() const
+{
+    // Conservative extent around the position: origin, rotation, flipping and text alignment can
+    // move the drawable away from its position by at most width + height. Local bounds of some
+    // drawables already contain the scale, so the scale is never used to shrink the extent.
+    auto const bounds = getLocalBounds();
+    auto const scale = getScale();
+    auto const shadowOffset = getShadowOffset();
+    auto const extent = bounds.width * std::max(std::abs(scale.x), 1.0f)
+        + bounds.height * std::max(std::abs(scale.y), 1.0f)
+        + static_cast<float>(getOutlineWidth()) + std::abs(shadowOffset.x)
+        + std::abs(shadowOffset.y);
+
+    auto const position = getScreenPosition() + getOffset() + getShakeOffset();
+    return jt::Rectf { position.x - extent, position.y - extent, 2.0f * extent, 2.0f * extent };
+}
+
+jt::Rectf jt::DrawableImpl::getScreenExtent(std::span<jt::Vector2f const> positions) const
+{
+    // the extent of the drawable, moved over the bounding box of all instance positions
+    auto const position = getPosition();
+    jt::Vector2f minDelta { positions.front() - position };
+    jt::Vector2f maxDelta { minDelta };
+    for (auto const& p : positions) {
+        minDelta = jt::Vector2f { std::min(minDelta.x, p.x - position.x),
+            std::min(minDelta.y, p.y - position.y) };
+        maxDelta = jt::Vector2f { std::max(maxDelta.x, p.x - position.x),
+            std::max(maxDelta.y, p.y - position.y) };
+    }
+    auto const extent = getScreenExtent();
+    return jt::Rectf { extent.left + minDelta.x, extent.top + minDelta.y,
+        extent.width + maxDelta.x - minDelta.x, extent.height + maxDelta.y - minDelta.y };
+}
+
+jt::Rectf jt::DrawableImpl::getScreenExtent(std::span<jt::DrawInstance const> instances) const
+{
+    // the extent of every instance is scaled around its center, so instances that are scaled up
+    // are still covered
+    auto const position = getPosition();
+    auto const extent = getScreenExtent();
+    auto const center = jt::Vector2f { extent.left + 0.5f * extent.width,
+        extent.top + 0.5f * extent.height };
+    jt::Vector2f min { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    jt::Vector2f max { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    for (auto const& instance : instances) {
+        auto const factor
+            = std::max({ std::abs(instance.scale.x), std::abs(instance.scale.y), 1.0f });
+        auto const halfSize
+            = jt::Vector2f { 0.5f * extent.width * factor, 0.5f * extent.height * factor };
+        auto const instanceCenter = center + instance.position - position;
+        min = jt::Vector2f { std::min(min.x, instanceCenter.x - halfSize.x),
+            std::min(min.y, instanceCenter.y - halfSize.y) };
+        max = jt::Vector2f { std::max(max.x, instanceCenter.x + halfSize.x),
+            std::max(max.y, instanceCenter.y + halfSize.y) };
+    }
+    return jt::Rectf { min.x, min.y, max.x - min.x, max.y - min.y };
+}
+
+void jt::DrawableImpl::setBlendMode(jt::BlendMode mode)
+{
+    if (m_blendMode != mode) {
+        m_blendMode = mode;
+        markContentChanged();
+    }
+}
 
 jt::BlendMode jt::DrawableImpl::getBlendMode() const { return m_blendMode; }
 
@@ -182,14 +534,51 @@ void jt::DrawableImpl::setCamMovementFactor(float factor)
     m_camMovementFactor = factor;
     bool const ignoreCamMovement = m_camMovementFactor != 1.0f;
     m_ignoreCamMovement = ignoreCamMovement;
+    markTransformDirty();
 }
 
 float jt::DrawableImpl::getCamMovementFactor() const { return m_camMovementFactor; }
 
-void jt::DrawableImpl::setZ(int z) { m_z = z; }
+void jt::DrawableImpl::setZ(int z)
+{
+    if (z == m_z) {
+        return;
+    }
+    auto const target = m_renderTarget.lock();
+    if (target) {
+        // the drawable is no longer drawn into the old z layer
+        target->invalidateLayer(m_z, m_drawnScreenBounds);
+    }
+    m_z = z;
+    m_drawnScreenBounds = jt::Rectf { 0.0f, 0.0f, 0.0f, 0.0f };
+    markContentChanged();
+}
 
 int jt::DrawableImpl::getZ() const { return m_z; }
 
+void jt::DrawableImpl::markTransformDirty() const noexcept { m_transformDirty = true; }
+
+void jt::DrawableImpl::markContentChanged() const noexcept { m_contentChanged = true; }
+
+void jt::DrawableImpl::invalidateLayer(
+    jt::RenderTargetInterface& target, jt::Rectf const& screenBounds) const
+{
+    target.invalidateLayer(m_z, m_drawnScreenBounds);
+    target.invalidateLayer(m_z, screenBounds);
+    m_drawnScreenBounds = screenBounds;
+    m_contentChanged = false;
+}
+
+void jt::DrawableImpl::refreshTransform() const
+{
+    if (!m_transformDirty && m_transformCamOffsetGeneration == m_camOffsetGeneration) {
+        return;
+    }
+    doRefreshTransform();
+    m_transformDirty = false;
+    m_transformCamOffsetGeneration = m_camOffsetGeneration;
+}
+
 bool jt::DrawableImpl::getOutlineActive() const { return getOutlineWidth() != 0; }
 
 jt::Color jt::DrawableImpl::getOutlineColor() const { return doGetOutlineColor(); }
@@ -5,14 +5,25 @@
 #include <graphics/flash_impl.hpp>
 #include <graphics/flicker_impl.hpp>
 #include <graphics/outline_impl.hpp>
+#include <graphics/render_queue.hpp>
 #include <graphics/rotation_impl.hpp>
 #include <graphics/shadow_impl.hpp>
 #include <graphics/shake_impl.hpp>
 #include <vector.hpp>
+#include <cstdint>
 #include <memory>
+#include <span>
 
 namespace jt {
 
+/// Properties of one instance for DrawableImpl::drawInstances()
+struct DrawInstance {
+    jt::Vector2f position { 0.0f, 0.0f };
+    jt::Vector2f scale { 1.0f, 1.0f };
+    float rotation { 0.0f };
+    jt::Color color { jt::colors::White };
+};
+
 ///  Implements common functionality of all Drawable classes
 class DrawableImpl :
     //
@@ -28,12 +39,44 @@ public:
     using Sptr = std::shared_ptr<DrawableImpl>;
 
     /// Destructor
-    virtual ~DrawableImpl() = default;
+    /// Invalidates the area of a cached z layer the drawable was drawn to
+    virtual ~DrawableImpl();
 
     void draw(std::shared_ptr<jt::RenderTargetInterface> targetContainer) const override;
 
     void draw(std::shared_ptr<jt::RenderTargetLayer> targets) const;
 
+    /// Draw the drawable at several positions in one batch, e.g. for tiles or repeated parts.
+    /// The position of the drawable is replaced by each of the positions, all other properties
+    /// (color, scale, rotation, offset, ...) are shared by all instances. Shadow, outline and flash
+    /// are not drawn for instances. Nothing is drawn if no instance can be on screen. Instances
+    /// that moved invalidate a cached z layer.
+    /// \param targetContainer the render target
+    /// \param positions positions of the instances
+    void drawInstances(std::shared_ptr<jt::RenderTargetInterface> targetContainer,
+        std::span<jt::Vector2f const> positions) const;
+
+    /// Draw the drawable at several positions in one batch into a specific layer
+    /// \param sptr the layer
+    /// \param positions positions of the instances
+    void drawInstances(std::shared_ptr<jt::RenderTargetLayer> sptr,
+        std::span<jt::Vector2f const> positions) const;
+
+    /// Draw the drawable several times in one batch, each instance with its own position, scale,
+    /// rotation and color, e.g. for particles. All other properties (origin, offset, blend mode,
+    /// ...) are shared by all instances. Shadow, outline and flash are not drawn for instances.
+    /// Nothing is drawn if no instance can be on screen.
+    /// \param targetContainer the render target
+    /// \param instances the instances
+    void drawInstances(std::shared_ptr<jt::RenderTargetInterface> targetContainer,
+        std::span<jt::DrawInstance const> instances) const;
+
+    /// Draw the drawable several times in one batch into a specific layer
+    /// \param sptr the layer
+    /// \param instances the instances
+    void drawInstances(std::shared_ptr<jt::RenderTargetLayer> sptr,
+        std::span<jt::DrawInstance const> instances) const;
+
     void flash(float t, jt::Color col = jt::colors::White) override;
     void shake(float t, float strength, float shakeInterval = 0.05f) override;
     void flicker(float duration, float interval = 0.05f) override;
@@ -81,6 +124,29 @@ public:
     // do not call this manually. Only place for this to be called is Game()->update();
     static void setCamOffset(jt::Vector2f const& v);
 
+    /// Get the render queue drawables submit their draw commands to
+    /// \return the render queue, can be nullptr
+    static std::shared_ptr<jt::RenderQueue> const& getRenderQueue();
+
+    // do not call this manually. Only place for this to be called is GfxImpl
+    static void setRenderQueue(std::shared_ptr<jt::RenderQueue> queue);
+
+    /// Get the size of the visible area in pixel, used for culling
+    /// \return the view size, (0,0) if unknown
+    static jt::Vector2f getStaticViewSize();
+
+    // do not call this manually. Only place for this to be called is GfxImpl
+    static void setStaticViewSize(jt::Vector2f const& size);
+
+    /// Enable or disable culling of this drawable. If enabled (default), the drawable is not drawn
+    /// when it is outside of the view.
+    /// \param enabled true to enable culling, false to always draw the drawable
+    void setCullingEnabled(bool enabled);
+
+    /// Check if culling is enabled for this drawable
+    /// \return true if culling is enabled, false otherwise
+    bool getCullingEnabled() const;
+
     void setScreenSizeHint(Vector2f const& hint) override;
 
     Vector2f getScreenSizeHint() const override;
@@ -97,13 +163,44 @@ public:
     void setZ(int z) override;
     int getZ() const override;
 
+    /// Mark the drawable as looking different than when it was drawn last, so a cached z layer
+    /// showing it is redrawn. Position, scale, offset, origin, rotation, color and effects are
+    /// tracked automatically. Call this for other visible changes (e.g. a new text or animation
+    /// frame) or when the drawable stops being drawn.
+    void markContentChanged() const noexcept;
+
+    // do not call this manually. Only place for this to be called is GfxImpl
+    static void setStaticRenderTarget(std::weak_ptr<jt::RenderTargetInterface> target);
+
 protected:
     jt::Vector2f getShakeOffset() const;
     jt::Vector2f getCamOffset() const;
     jt::Vector2f m_screenSizeHint { 0.0f, 0.0f };
 
+    /// Get the view size used for culling: the screen size hint if set, the view size otherwise
+    /// \return the view size, (0,0) if culling is not possible
+    jt::Vector2f getCullingViewSize() const;
+
     virtual void setOriginInternal(jt::Vector2f const& /*origin*/) { }
 
+    /// Check if the drawable submits its draw commands to the render queue.
+    /// Drawables that draw immediately flush the render queue before drawing to keep the order.
+    /// \return true if only the render queue is used for drawing, false otherwise
+    virtual bool usesRenderQueue() const { return false; }
+
+    /// Draw a command via the render queue, or immediately if there is no render queue
+    /// \param command the command
+    /// \param queued if false, the render queue is flushed and the command is drawn immediately
+    void submit(jt::RenderCommand const& command, bool queued = true) const;
+
+    /// Mark the backend transform (e.g. sf::Sprite position or SDL dest rect) as outdated.
+    /// Call this whenever a value changes that goes into the transform.
+    void markTransformDirty() const noexcept;
+
+    /// Recalculate the backend transform via doRefreshTransform(), if it is outdated or the camera
+    /// moved since the last call
+    void refreshTransform() const;
+
     float m_camMovementFactor { 1.0f };
 
     jt::OriginMode m_originMode { jt::OriginMode::MANUAL };
@@ -111,7 +208,11 @@ protected:
 
 private:
     static jt::Vector2f m_CamOffset;
+    static std::shared_ptr<jt::RenderQueue> m_renderQueue;
+    static jt::Vector2f m_viewSize;
+    static std::weak_ptr<jt::RenderTargetInterface> m_renderTarget;
     bool m_ignoreCamMovement { false };
+    bool m_cullingEnabled { true };
 
     bool m_hasBeenUpdated { false };
 
@@ -122,6 +223,49 @@ private:
 
     int m_z { 0 };
 
+    static std::uint64_t m_camOffsetGeneration;
+    mutable bool m_transformDirty { true };
+    mutable std::uint64_t m_transformCamOffsetGeneration { 0u };
+
+    // visible properties at the last update, used to detect changes for cached z layers
+    struct VisibleState {
+        jt::Vector2f position { 0.0f, 0.0f };
+        jt::Vector2f scale { 1.0f, 1.0f };
+        jt::Vector2f offset { 0.0f, 0.0f };
+        jt::Vector2f origin { 0.0f, 0.0f };
+        jt::Vector2f shakeOffset { 0.0f, 0.0f };
+        float rotation { 0.0f };
+        jt::Color color { jt::colors::White };
+        jt::Color flashColor { jt::colors::White };
+        bool drawnFromFlicker { true };
+
+        bool operator==(VisibleState const& other) const = default;
+    };
+    VisibleState m_visibleState {};
+    mutable bool m_contentChanged { true };
+    mutable bool m_drawnIntoCachedLayer { false };
+    mutable jt::Rectf m_drawnScreenBounds { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    // conservative area the drawable covers on screen
+    jt::Rectf getScreenExtent() const;
+
+    // conservative area all instances cover on screen, instances must not be empty
+    jt::Rectf getScreenExtent(std::span<jt::Vector2f const> positions) const;
+    jt::Rectf getScreenExtent(std::span<jt::DrawInstance const> instances) const;
+
+    // invalidate the area of the z layer the drawable covered before and covers now
+    void invalidateLayer(jt::RenderTargetInterface& target, jt::Rectf const& screenBounds) const;
+
+    // check if any instance at the positions can be on screen
+    bool isVisible(std::span<jt::Vector2f const> positions) const;
+    bool isVisible(std::span<jt::DrawInstance const> instances) const;
+
+    static bool isOnScreen(jt::Rectf const& extent, jt::Vector2f const& viewSize);
+
+    // overwrite this method to calculate the backend transform from position, scale, shake, offset
+    // and cam offset. Is called before the drawable is drawn.
+    virtual void doRefreshTransform() const { }
+
     // overwrite this method:
     // things to take care of:
     //   - make sure flash object and normal object are at the same position
@@ -129,6 +273,15 @@ private:
 
     // overwrite this method
     virtual void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const = 0;
+
+    // overwrite this method to draw instances with positions in one batch. The default moves the
+    // drawable to every position and draws it, which is not thread safe.
+    virtual void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const;
+
+    // overwrite this method to support drawInstances() with DrawInstances
+    virtual void doDrawTransformedInstances(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/,
+        std::span<jt::DrawInstance const> /*instances*/) const;
 };
 
 } // namespace jt
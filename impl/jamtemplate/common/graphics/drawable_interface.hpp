@@ -203,7 +203,8 @@ public:
     /// \return the cam movement factor
     virtual float getCamMovementFactor() const = 0;
 
-    /// Set the screensize hint. This will be used to avoid drawing of off-screen drawables.
+    /// Set the screensize hint. This will be used instead of the view size to avoid drawing of
+    /// off-screen drawables.
     /// \param hint the size of the screen
     virtual void setScreenSizeHint(jt::Vector2f const& hint) = 0;
 
@@ -219,7 +220,7 @@ public:
     /// \return the blend mode
     virtual jt::BlendMode getBlendMode() const = 0;
 
-    /// check if is visible, based on ScreenSizeHint
+    /// check if is visible, based on the view size or ScreenSizeHint
     /// \return true if visible, false if not
     virtual bool isVisible() const = 0;
 
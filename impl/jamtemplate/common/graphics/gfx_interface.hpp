@@ -41,9 +41,17 @@ public:
 
     /// Create a ZLayer (to be used with DrawableInterface::setZ())
     /// \param z The z layer. Drawables will be drawn in ascending order, that means z layer 2 is
-    /// drawn above z layer 1.
+    /// drawn above z layer 1. Creating an existing ZLayer has no effect.
     virtual void createZLayer(int z) = 0;
 
+    /// Enable or disable sorting of draw calls within a ZLayer.
+    /// Sorting groups draw calls by blend mode and texture to reduce state changes, but drawables
+    /// in a sorted ZLayer are no longer guaranteed to be drawn in call order. Use this for ZLayers
+    /// with many non-overlapping drawables, e.g. particles.
+    /// \param z The z layer. Needs to be created via createZLayer() before.
+    /// \param sorted true to sort draw calls, false to draw in call order (default)
+    virtual void setZLayerSorted(int z, bool sorted) = 0;
+
     virtual ~GfxInterface() = default;
 
     // no copy, no move. Avoid slicing.
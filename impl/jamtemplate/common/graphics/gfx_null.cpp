@@ -21,3 +21,5 @@ void jt::null_objects::GfxNull::clear() { }
 void jt::null_objects::GfxNull::display() { }
 
 void jt::null_objects::GfxNull::createZLayer(int /*z*/) { }
+
+void jt::null_objects::GfxNull::setZLayerSorted(int /*z*/, bool /*sorted*/) { }
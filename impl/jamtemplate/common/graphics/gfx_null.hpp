@@ -25,6 +25,7 @@ public:
     void display() override;
 
     void createZLayer(int z) override;
+    void setZLayerSorted(int z, bool sorted) override;
 
 private:
     RenderWindowNull m_window;
@@ -0,0 +1,96 @@
+#include "layer_states.hpp"
+
+void jt::LayerStates::add(int z) { m_states[z] = State {}; }
+
+void jt::LayerStates::touch(int z) { m_states[z].touched = true; }
+
+void jt::LayerStates::setCached(int z, bool cached)
+{
+    auto& state = m_states[z];
+    if (cached && !state.cached) {
+        // the layer was not drawn completely before, so the first frame needs a full redraw
+        state.dirty = true;
+    }
+    state.cached = cached;
+}
+
+bool jt::LayerStates::isCached(int z) const
+{
+    auto const it = m_states.find(z);
+    return it != m_states.cend() && it->second.cached;
+}
+
+void jt::LayerStates::setIgnoresCamMovement(int z, bool ignore)
+{
+    m_states[z].ignoresCamMovement = ignore;
+}
+
+void jt::LayerStates::invalidate(int z)
+{
+    // layers that were never used have nothing to invalidate
+    auto const it = m_states.find(z);
+    if (it != m_states.end()) {
+        it->second.dirty = true;
+    }
+}
+
+void jt::LayerStates::invalidate(int z, jt::Rectf const& rect, jt::Vector2f const& layerSize)
+{
+    if (rect.left >= layerSize.x || rect.top >= layerSize.y || rect.left + rect.width <= 0.0f
+        || rect.top + rect.height <= 0.0f) {
+        // dirty rect is not on screen, so the cached pixels are still valid
+        return;
+    }
+    invalidate(z);
+}
+
+void jt::LayerStates::invalidateCamLayers()
+{
+    for (auto& kvp : m_states) {
+        if (!kvp.second.ignoresCamMovement) {
+            kvp.second.dirty = true;
+        }
+    }
+}
+
+void jt::LayerStates::reset()
+{
+    for (auto& kvp : m_states) {
+        kvp.second.cached = false;
+        kvp.second.ignoresCamMovement = false;
+        kvp.second.dirty = true;
+    }
+}
+
+bool jt::LayerStates::beginFrame(int z)
+{
+    auto& state = m_states[z];
+    bool needsClear { state.touched };
+    if (state.cached) {
+        state.redraw = state.dirty;
+        needsClear = state.redraw;
+    } else {
+        state.redraw = true;
+    }
+    state.dirty = false;
+    state.touched = false;
+    return needsClear;
+}
+
+bool jt::LayerStates::needsRedraw(int z) const
+{
+    auto const it = m_states.find(z);
+    if (it == m_states.cend()) {
+        return true;
+    }
+    return !it->second.cached || it->second.redraw;
+}
+
+bool jt::LayerStates::hasContent(int z) const
+{
+    auto const it = m_states.find(z);
+    if (it == m_states.cend()) {
+        return false;
+    }
+    return it->second.touched || it->second.cached;
+}
@@ -0,0 +1,81 @@
+#ifndef JAMTEMPLATE_LAYER_STATES_HPP
+#define JAMTEMPLATE_LAYER_STATES_HPP
+
+#include <rect.hpp>
+#include <vector.hpp>
+#include <map>
+
+namespace jt {
+
+/// Book keeping for the z layers of a RenderTarget: which layers were drawn to, which layers are
+/// cached across frames and which cached layers need to be redrawn.
+class LayerStates {
+public:
+    /// Register a new layer. The content of new layers is undefined, so they are cleared once.
+    /// \param z the z layer
+    void add(int z);
+
+    /// Mark a layer as drawn to in this frame
+    /// \param z the z layer
+    void touch(int z);
+
+    /// Set if a layer is cached across frames
+    /// \param z the z layer
+    /// \param cached true if the layer content should be kept, false otherwise
+    void setCached(int z, bool cached);
+
+    /// Check if a layer is cached across frames
+    /// \param z the z layer
+    /// \return true if the layer is cached, false otherwise
+    bool isCached(int z) const;
+
+    /// Set if a layer is kept when the camera moves
+    /// \param z the z layer
+    /// \param ignore true if the layer does not depend on the camera, false otherwise
+    void setIgnoresCamMovement(int z, bool ignore);
+
+    /// Invalidate a cached layer, so it is redrawn in the next frame
+    /// \param z the z layer
+    void invalidate(int z);
+
+    /// Invalidate a cached layer if rect overlaps the layer area
+    /// \param z the z layer
+    /// \param rect the dirty rect in screen coordinates
+    /// \param layerSize size of the layer in pixel
+    void invalidate(int z, jt::Rectf const& rect, jt::Vector2f const& layerSize);
+
+    /// Invalidate all cached layers that depend on the camera
+    void invalidateCamLayers();
+
+    /// Stop caching all layers and invalidate them
+    void reset();
+
+    /// Start a new frame for a layer
+    /// \param z the z layer
+    /// \return true if the layer needs to be cleared, false otherwise
+    bool beginFrame(int z);
+
+    /// Check if drawables need to be drawn into a layer in this frame
+    /// \param z the z layer
+    /// \return true if the layer needs to be redrawn, false otherwise
+    bool needsRedraw(int z) const;
+
+    /// Check if a layer can contain pixels in this frame
+    /// \param z the z layer
+    /// \return true if the layer needs to be composited, false otherwise
+    bool hasContent(int z) const;
+
+private:
+    struct State {
+        bool touched { true };
+        bool cached { false };
+        bool ignoresCamMovement { false };
+        bool dirty { true };
+        bool redraw { true };
+    };
+    std::map<int, State> m_states;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_LAYER_STATES_HPP
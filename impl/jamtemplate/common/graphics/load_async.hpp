@@ -0,0 +1,16 @@
+#ifndef JAMTEMPLATE_LOAD_ASYNC_HPP
+#define JAMTEMPLATE_LOAD_ASYNC_HPP
+
+namespace jt {
+
+/// Tag type to create a drawable without waiting for its texture to be decoded, e.g.
+/// jt::Sprite { fileName, textureManager, jt::loadAsync }.
+struct LoadAsyncTag {
+    explicit LoadAsyncTag() = default;
+};
+
+inline constexpr LoadAsyncTag loadAsync {};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_LOAD_ASYNC_HPP
@@ -0,0 +1,87 @@
+#include "render_queue.hpp"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <stdexcept>
+
+void jt::RenderQueue::push(jt::RenderCommand const& command)
+{
+    auto const targetIndex = getTargetIndex(command.getTarget());
+    auto key = targetIndex << 48u;
+    if (m_targetSorted[targetIndex]) {
+        key |= command.getStateKey() & 0xFFFFFFFFFFFFu;
+    }
+    m_keys.push_back(key);
+    m_commands.push_back(command);
+}
+
+void jt::RenderQueue::setTargetSorted(void const* target, bool sorted)
+{
+    // keys of already queued commands were created with the old setting
+    flush();
+    m_targetSorted[getTargetIndex(target)] = sorted;
+}
+
+void jt::RenderQueue::flush()
+{
+    if (m_commands.empty()) {
+        return;
+    }
+    ZoneScopedN("jt::RenderQueue::flush");
+    sort();
+    jt::submitRenderCommands(m_commands, m_order);
+
+    m_commands.clear();
+    m_keys.clear();
+}
+
+std::size_t jt::RenderQueue::size() const noexcept { return m_commands.size(); }
+
+bool jt::RenderQueue::empty() const noexcept { return m_commands.empty(); }
+
+std::uint64_t jt::RenderQueue::getTargetIndex(void const* target)
+{
+    // there are only a handful of ZLayers, so a linear search is fastest
+    auto const it = std::find(m_targets.cbegin(), m_targets.cend(), target);
+    if (it != m_targets.cend()) [[likely]] {
+        return static_cast<std::uint64_t>(std::distance(m_targets.cbegin(), it));
+    }
+    if (m_targets.size() == 0xFFFFu) [[unlikely]] {
+        throw std::logic_error { "RenderQueue supports at most 65535 targets" };
+    }
+    m_targets.push_back(target);
+    m_targetSorted.push_back(false);
+    return static_cast<std::uint64_t>(m_targets.size() - 1u);
+}
+
+void jt::RenderQueue::sort()
+{
+    auto const count = m_keys.size();
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    m_orderSwap.resize(count);
+
+    // LSD radix sort over the bytes of the sort key. It is stable, so commands with equal keys are
+    // drawn in call order.
+    for (auto shift = 0u; shift != 64u; shift += 8u) {
+        std::array<std::size_t, 256> histogram {};
+        for (auto const key : m_keys) {
+            ++histogram[(key >> shift) & 0xFFu];
+        }
+        // all keys share the same byte, order does not change
+        if (histogram[(m_keys.front() >> shift) & 0xFFu] == count) {
+            continue;
+        }
+        std::size_t offset { 0u };
+        for (auto& bucket : histogram) {
+            auto const bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+        for (auto const idx : m_order) {
+            m_orderSwap[histogram[(m_keys[idx] >> shift) & 0xFFu]++] = idx;
+        }
+        std::swap(m_order, m_orderSwap);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef JAMTEMPLATE_RENDER_QUEUE_HPP
+#define JAMTEMPLATE_RENDER_QUEUE_HPP
+
+#include <render_command_lib.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jt {
+
+/// Collects the draw commands of a frame and submits them grouped by ZLayer.
+///
+/// Commands drawn into the same ZLayer keep their call order, unless sorting is enabled for that
+/// ZLayer. In a sorted ZLayer commands are additionally ordered by blend mode and texture to keep
+/// state changes at a minimum.
+class RenderQueue {
+public:
+    /// Add a command to the queue
+    /// \param command the command
+    void push(jt::RenderCommand const& command);
+
+    /// Enable or disable sorting by blend mode and texture for all commands drawn into target
+    /// \param target the target as returned by RenderCommand::getTarget()
+    /// \param sorted true if commands should be sorted, false to keep the call order
+    void setTargetSorted(void const* target, bool sorted);
+
+    /// Sort and draw all queued commands and clear the queue afterwards
+    void flush();
+
+    /// Get the number of queued commands
+    /// \return the number of queued commands
+    std::size_t size() const noexcept;
+
+    /// Check if there are queued commands
+    /// \return true if no commands are queued, false otherwise
+    bool empty() const noexcept;
+
+private:
+    std::vector<jt::RenderCommand> m_commands;
+    std::vector<std::uint64_t> m_keys;
+
+    std::vector<std::uint32_t> m_order;
+    std::vector<std::uint32_t> m_orderSwap;
+
+    // targets in order of first use. The index in this vector is the upper part of the sort key.
+    std::vector<void const*> m_targets;
+    std::vector<bool> m_targetSorted;
+
+    std::uint64_t getTargetIndex(void const* target);
+    void sort();
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_RENDER_QUEUE_HPP
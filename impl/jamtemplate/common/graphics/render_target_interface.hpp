@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_RENDER_TARGET_INTERFACE_HPP
 #define JAMTEMPLATE_RENDER_TARGET_INTERFACE_HPP
 
+#include <rect.hpp>
 #include <render_target_layer.hpp>
 #include <functional>
 #include <map>
@@ -15,6 +16,39 @@ public:
     /// \return the RenderTargetLayer
     virtual std::shared_ptr<jt::RenderTargetLayer> get(int z) = 0;
 
+    /// Check if drawables need to be drawn into a z layer in this frame
+    /// \param z the z value
+    /// \return false if the z layer is cached and its content is still valid, true otherwise
+    virtual bool needsRedraw(int z) const = 0;
+
+    /// Keep the content of a z layer across frames. A cached z layer is only redrawn after it was
+    /// invalidated, a drawable in it changed or the camera moved. Use this for static backgrounds
+    /// and UI.
+    /// \param z the z value
+    /// \param cached true to cache the z layer, false to redraw it every frame (default)
+    virtual void setLayerCached(int z, bool cached) = 0;
+
+    /// Check if a z layer is cached across frames
+    /// \param z the z value
+    /// \return true if the z layer is cached, false otherwise
+    virtual bool isLayerCached(int z) const = 0;
+
+    /// Keep a cached z layer when the camera moves. Use this if all drawables in the z layer
+    /// ignore the camera movement, e.g. for HUD and menus.
+    /// \param z the z value
+    /// \param ignore true if the z layer does not depend on the camera, false otherwise (default)
+    virtual void setLayerIgnoresCamMovement(int z, bool ignore) = 0;
+
+    /// Invalidate a part of a cached z layer, so the z layer is redrawn in the next frame
+    /// \param z the z value
+    /// \param rect the area that changed in screen coordinates. Areas outside of the screen do not
+    /// invalidate the z layer.
+    virtual void invalidateLayer(int z, jt::Rectf const& rect) = 0;
+
+    /// Stop caching all z layers and redraw them in the next frame, e.g. when the game state
+    /// changes
+    virtual void resetLayers() = 0;
+
     virtual ~RenderTargetInterface() = default;
 
     // no copy, no move. Avoid slicing.
@@ -0,0 +1,220 @@
+#ifndef JAMTEMPLATE_PARTICLE_BATCH_HPP
+#define JAMTEMPLATE_PARTICLE_BATCH_HPP
+
+#include <color/color.hpp>
+#include <game_object.hpp>
+#include <graphics/drawable_impl.hpp>
+#include <vector.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace jt {
+
+/// Start values of one particle in a ParticleBatch
+struct Particle {
+    jt::Vector2f position { 0.0f, 0.0f };
+    /// velocity in pixel per second
+    jt::Vector2f velocity { 0.0f, 0.0f };
+    /// acceleration in pixel per second squared, e.g. for gravity
+    jt::Vector2f acceleration { 0.0f, 0.0f };
+    /// time in seconds until the particle disappears
+    float lifetime { 1.0f };
+    jt::Color color { jt::colors::White };
+    jt::Vector2f scale { 1.0f, 1.0f };
+    /// rotation in degree
+    float rotation { 0.0f };
+    /// rotation speed in degree per second
+    float angularVelocity { 0.0f };
+};
+
+/// Particle system that stores plain particle values instead of one drawable per particle.
+/// Movement, rotation, fading and scaling are built in, all particles are drawn as instances of a
+/// single drawable in one batch.
+template <std::size_t N>
+class ParticleBatch : public GameObject {
+public:
+    using SpawnCallbackType = std::function<void(jt::Particle& particle, jt::Vector2f const& pos)>;
+
+    /// Create a ParticleBatch
+    /// \param drawable drawable used for all particles. Needs to support drawInstances() with
+    /// DrawInstances, e.g. jt::Shape.
+    /// \param spawn spawn callback, sets the start values of a particle. The particle passed in
+    /// has its position set to the fire position.
+    /// \return shared pointer to the created ParticleBatch
+    static std::shared_ptr<ParticleBatch<N>> createPB(
+        std::shared_ptr<jt::DrawableImpl> drawable, SpawnCallbackType const& spawn)
+    {
+        return std::make_shared<ParticleBatch<N>>(drawable, spawn);
+    }
+
+    /// Constructor
+    /// \param drawable drawable used for all particles
+    /// \param spawn spawn callback
+    ParticleBatch(std::shared_ptr<jt::DrawableImpl> drawable, SpawnCallbackType const& spawn)
+        : m_drawable { drawable }
+        , m_spawnCallback { spawn }
+    {
+        if (!m_drawable) {
+            throw std::invalid_argument { "ParticleBatch created with nullptr drawable" };
+        }
+        m_instances.reserve(N);
+        m_shadowInstances.reserve(N);
+        m_alphaCurve.fill(1.0f);
+        m_scaleCurve.fill(1.0f);
+    }
+
+    /// Fire the particle batch, spawning num particles. If all particles are in use, the oldest
+    /// particles are replaced.
+    /// \param num the amount of particles to spawn
+    /// \param pos the position where to spawn the particles
+    void fire(unsigned int num = 1, jt::Vector2f const& pos = jt::Vector2f {})
+    {
+        for (auto i = 0u; i != num; ++i) {
+            jt::Particle particle {};
+            particle.position = pos;
+            m_spawnCallback(particle, pos);
+
+            auto const idx = m_nextIndex;
+            m_positions[idx] = particle.position;
+            m_velocities[idx] = particle.velocity;
+            m_accelerations[idx] = particle.acceleration;
+            m_ages[idx] = 0.0f;
+            m_lifetimes[idx] = particle.lifetime;
+            m_colors[idx] = particle.color;
+            m_scales[idx] = particle.scale;
+            m_rotations[idx] = particle.rotation;
+            m_angularVelocities[idx] = particle.angularVelocity;
+
+            m_nextIndex = (m_nextIndex + 1u) % N;
+        }
+    }
+
+    /// Set the alpha of the particles over their lifetime
+    /// \param points (age relative to lifetime in [0, 1], alpha factor) pairs in ascending order.
+    /// The alpha of the particle color is multiplied by the linear interpolated factor.
+    void setAlphaCurve(std::vector<jt::Vector2f> const& points) { bakeCurve(points, m_alphaCurve); }
+
+    /// Set the scale of the particles over their lifetime
+    /// \param points (age relative to lifetime in [0, 1], scale factor) pairs in ascending order.
+    /// The scale of the particle is multiplied by the linear interpolated factor.
+    void setScaleCurve(std::vector<jt::Vector2f> const& points) { bakeCurve(points, m_scaleCurve); }
+
+private:
+    // curves are sampled once, so evaluating them per particle is a lookup
+    static constexpr std::size_t curveResolution { 64u };
+    using CurveType = std::array<float, curveResolution>;
+
+    std::shared_ptr<jt::DrawableImpl> m_drawable { nullptr };
+    SpawnCallbackType m_spawnCallback {};
+
+    std::array<jt::Vector2f, N> m_positions {};
+    std::array<jt::Vector2f, N> m_velocities {};
+    std::array<jt::Vector2f, N> m_accelerations {};
+    std::array<float, N> m_ages {};
+    // particles are alive while age < lifetime, so all particles start dead
+    std::array<float, N> m_lifetimes {};
+    std::array<jt::Color, N> m_colors {};
+    std::array<jt::Vector2f, N> m_scales {};
+    std::array<float, N> m_rotations {};
+    std::array<float, N> m_angularVelocities {};
+    std::size_t m_nextIndex { 0u };
+
+    CurveType m_alphaCurve {};
+    CurveType m_scaleCurve {};
+
+    mutable std::vector<jt::DrawInstance> m_instances {};
+    mutable std::vector<jt::DrawInstance> m_shadowInstances {};
+
+    static void bakeCurve(std::vector<jt::Vector2f> const& points, CurveType& curve)
+    {
+        if (points.empty()) {
+            throw std::invalid_argument { "particle curve needs at least one point" };
+        }
+        if (!std::is_sorted(points.cbegin(), points.cend(),
+                [](auto const& a, auto const& b) { return a.x < b.x; })) {
+            throw std::invalid_argument { "particle curve points need to be in ascending order" };
+        }
+        for (auto i = 0u; i != curveResolution; ++i) {
+            auto const t = static_cast<float>(i) / static_cast<float>(curveResolution - 1u);
+            auto const upper = std::find_if(
+                points.cbegin(), points.cend(), [t](auto const& p) { return p.x >= t; });
+            if (upper == points.cbegin()) {
+                curve[i] = upper->y;
+            } else if (upper == points.cend()) {
+                curve[i] = points.back().y;
+            } else {
+                auto const lower = std::prev(upper);
+                auto const range = upper->x - lower->x;
+                auto const f = range <= 0.0f ? 1.0f : (t - lower->x) / range;
+                curve[i] = lower->y + (upper->y - lower->y) * f;
+            }
+        }
+    }
+
+    static float evaluateCurve(CurveType const& curve, float t)
+    {
+        auto const idx = static_cast<std::size_t>(
+            std::clamp(t, 0.0f, 1.0f) * static_cast<float>(curveResolution - 1u));
+        return curve[idx];
+    }
+
+    void doUpdate(float const elapsed) override
+    {
+        m_drawable->update(elapsed);
+        for (auto i = 0u; i != N; ++i) {
+            if (m_ages[i] >= m_lifetimes[i]) {
+                continue;
+            }
+            m_ages[i] += elapsed;
+            m_velocities[i] += m_accelerations[i] * elapsed;
+            m_positions[i] += m_velocities[i] * elapsed;
+            m_rotations[i] += m_angularVelocities[i] * elapsed;
+        }
+    }
+
+    void doDraw() const override
+    {
+        m_instances.clear();
+        for (auto i = 0u; i != N; ++i) {
+            if (m_ages[i] >= m_lifetimes[i]) {
+                continue;
+            }
+            auto const t = m_ages[i] / m_lifetimes[i];
+            auto const alphaFactor = std::clamp(evaluateCurve(m_alphaCurve, t), 0.0f, 1.0f);
+            auto color = m_colors[i];
+            color.a = static_cast<std::uint8_t>(static_cast<float>(color.a) * alphaFactor);
+            m_instances.push_back(jt::DrawInstance { m_positions[i],
+                m_scales[i] * evaluateCurve(m_scaleCurve, t), m_rotations[i], color });
+        }
+        if (m_instances.empty()) {
+            return;
+        }
+
+        if (m_drawable->getShadowActive()) {
+            // shadows of all particles are drawn as a separate batch below the particles
+            m_shadowInstances.assign(m_instances.cbegin(), m_instances.cend());
+            auto const shadowColor = m_drawable->getShadowColor();
+            auto const shadowOffset = m_drawable->getShadowOffset();
+            for (auto& shadow : m_shadowInstances) {
+                shadow.position += shadowOffset;
+                auto const alpha = static_cast<float>(shadowColor.a)
+                    * static_cast<float>(shadow.color.a) / 255.0f;
+                shadow.color = shadowColor;
+                shadow.color.a = static_cast<std::uint8_t>(alpha);
+            }
+            m_drawable->drawInstances(renderTarget(), m_shadowInstances);
+        }
+        m_drawable->drawInstances(renderTarget(), m_instances);
+    }
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_PARTICLE_BATCH_HPP
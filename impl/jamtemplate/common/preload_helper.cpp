@@ -1 +1,43 @@
 #include "preload_helper.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+std::vector<std::string> jt::PreloadHelper::detail::collectFiles(
+    std::string const& folder, std::string const& extension, bool recursive)
+{
+    if (!std::filesystem::is_directory(folder)) {
+        throw std::invalid_argument { "folder '" + folder + "' is not a directory" };
+    }
+    auto ext = extension;
+    if (!ext.starts_with(".")) {
+        ext = "." + ext;
+    }
+
+    std::vector<std::string> files {};
+    auto const add = [&files, &ext](auto const& entry) {
+        std::string const path = entry.path().string();
+        if (path.ends_with(ext)) {
+            files.push_back(path);
+        }
+    };
+
+    if (recursive) {
+        for (auto const& entry : std::filesystem::recursive_directory_iterator { folder }) {
+            add(entry);
+        }
+    } else {
+        for (auto const& entry : std::filesystem::directory_iterator { folder }) {
+            add(entry);
+        }
+    }
+    return files;
+}
+
+std::size_t jt::PreloadHelper::detail::getNumberOfWorkers(std::size_t numberOfFiles)
+{
+    // hardware_concurrency() returns 0 if the number of cores is not known
+    auto const cores = std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()),
+        static_cast<std::size_t>(1u));
+    return std::clamp(numberOfFiles, static_cast<std::size_t>(1u), cores);
+}
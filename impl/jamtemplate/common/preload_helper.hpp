@@ -1,8 +1,15 @@
 #ifndef JAMTEMPLATE_PRELOAD_HELPER_HPP
 #define JAMTEMPLATE_PRELOAD_HELPER_HPP
 
-#include <filesystem>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace jt {
 namespace PreloadHelper {
@@ -14,35 +21,182 @@ concept HasGet = requires(T & t, std::string const& fileName)
     t.get(fileName);
 };
 
-void preloadAllFrom(HasGet auto& cache, std::string const& folder, std::string const& extension,
-    bool recursive = true)
+// caches that decode on worker threads on their own and need to finish loading on the calling
+// thread, e.g. the TextureManager
+template <typename T>
+concept HasPrefetch = HasGet<T> && requires(T & t, std::string const& fileName, float budget)
+{
+    t.prefetch(fileName);
+    t.isLoaded(fileName);
+    t.uploadPrefetched(budget);
+};
+
+// caches which can be used from multiple threads opt in via `static constexpr bool isThreadSafe`,
+// all other caches are only used from the calling thread
+template <typename T>
+concept IsThreadSafe = HasGet<T> && requires
+{
+    requires T::isThreadSafe;
+};
+
+/// Called on the calling thread of preloadAllFrom whenever files finished loading, e.g. to draw a
+/// loading screen. Arguments are the number of loaded files and the total number of files.
+using ProgressCallbackType = std::function<void(std::size_t loaded, std::size_t total)>;
+
+namespace detail {
+
+// the web build is not linked with pthreads, so no worker threads can be started there
+#if JT_ENABLE_WEB
+constexpr bool canStartThreads { false };
+#else
+constexpr bool canStartThreads { true };
+#endif
+
+std::vector<std::string> collectFiles(
+    std::string const& folder, std::string const& extension, bool recursive);
+
+std::size_t getNumberOfWorkers(std::size_t numberOfFiles);
+
+template <IsThreadSafe T>
+void loadOnWorkers(
+    T& cache, std::vector<std::string> const& files, ProgressCallbackType const& progress)
 {
-    if (!std::filesystem::is_directory(folder)) {
-        throw std::invalid_argument { "folder '" + folder + "' is not a directory" };
+    std::mutex mutex;
+    std::condition_variable fileFinished;
+    std::size_t nextFile { 0u };
+    std::size_t loaded { 0u };
+    std::exception_ptr error { nullptr };
+    auto const numberOfWorkers = getNumberOfWorkers(files.size());
+    std::size_t runningWorkers { numberOfWorkers };
+
+    auto const work = [&]() {
+        std::unique_lock lock { mutex };
+        while (nextFile != files.size() && !error) {
+            auto const& fileName = files[nextFile++];
+            lock.unlock();
+            std::exception_ptr fileError { nullptr };
+            try {
+                cache.get(fileName);
+            } catch (...) {
+                fileError = std::current_exception();
+            }
+            lock.lock();
+            if (fileError) {
+                error = fileError;
+            } else {
+                ++loaded;
+            }
+            fileFinished.notify_one();
+        }
+        --runningWorkers;
+        fileFinished.notify_one();
+    };
+
+    std::vector<std::jthread> workers {};
+    workers.reserve(numberOfWorkers);
+    for (auto i = 0u; i != numberOfWorkers; ++i) {
+        workers.emplace_back(work);
+    }
+
+    // progress is reported from this thread, so the callback does not need to be thread safe
+    std::size_t reported { 0u };
+    std::unique_lock lock { mutex };
+    while (runningWorkers != 0u || loaded != reported) {
+        fileFinished.wait(lock, [&]() { return loaded != reported || runningWorkers == 0u; });
+        if (loaded == reported) {
+            continue;
+        }
+        reported = loaded;
+        if (progress) {
+            lock.unlock();
+            progress(reported, files.size());
+            lock.lock();
+        }
     }
-    auto ext = extension;
-    if (!ext.starts_with(".")) {
-        ext = "." + ext;
+    lock.unlock();
+
+    if (error) {
+        std::rethrow_exception(error);
     }
+}
 
-    auto const fun = [&](auto f) {
-        std::string const path = f.path().string();
-        if (path.ends_with(extension)) {
-            cache.get(path);
+template <HasPrefetch T>
+void loadWithPrefetch(
+    T& cache, std::vector<std::string> const& files, ProgressCallbackType const& progress)
+{
+    // only a few files are prefetched at a time, so the decoded images do not pile up in memory
+    auto const maxFilesInFlight = getNumberOfWorkers(files.size());
+    std::vector<std::string> inFlight {};
+    std::size_t nextFile { 0u };
+    std::size_t loaded { 0u };
+    while (loaded != files.size()) {
+        while (nextFile != files.size() && inFlight.size() < maxFilesInFlight) {
+            cache.prefetch(files[nextFile]);
+            inFlight.push_back(files[nextFile]);
+            ++nextFile;
         }
-    };
 
-    if (recursive) {
-        for (auto file : std::filesystem::recursive_directory_iterator { folder }) {
-            fun(file);
+        cache.uploadPrefetched(std::numeric_limits<float>::max());
+        auto finished = std::erase_if(
+            inFlight, [&cache](auto const& fileName) { return cache.isLoaded(fileName); });
+        if (finished == 0u) {
+            // nothing is decoded yet, get() waits for the decode of the oldest file
+            cache.get(inFlight.front());
+            inFlight.erase(inFlight.begin());
+            finished = 1u;
         }
-    } else {
-        for (auto file : std::filesystem::directory_iterator { folder }) {
-            fun(file);
+
+        loaded += finished;
+        if (progress) {
+            progress(loaded, files.size());
+        }
+    }
+}
+
+template <HasGet T>
+void loadOnCallingThread(
+    T& cache, std::vector<std::string> const& files, ProgressCallbackType const& progress)
+{
+    for (std::size_t i = 0u; i != files.size(); ++i) {
+        cache.get(files[i]);
+        if (progress) {
+            progress(i + 1u, files.size());
         }
     }
 }
 
+template <HasGet T>
+void load(T& cache, std::vector<std::string> const& files, ProgressCallbackType const& progress)
+{
+    if constexpr (HasPrefetch<T>) {
+        loadWithPrefetch(cache, files, progress);
+    } else if constexpr (IsThreadSafe<T> && canStartThreads) {
+        loadOnWorkers(cache, files, progress);
+    } else {
+        loadOnCallingThread(cache, files, progress);
+    }
+}
+
+} // namespace detail
+
+/// Load all files with an extension from a folder into a cache. Caches which decode on their own
+/// worker threads via prefetch() (e.g. TextureManager) and caches which declare themselves thread
+/// safe (e.g. TilemapCache) load files in parallel, all other caches load them one after another.
+/// \param cache the cache to load the files into
+/// \param folder the folder to search for files
+/// \param extension the file extension, e.g. ".png"
+/// \param recursive true to include files in sub folders
+/// \param progress optional callback to report the loading progress
+void preloadAllFrom(HasGet auto& cache, std::string const& folder, std::string const& extension,
+    bool recursive = true, ProgressCallbackType const& progress = {})
+{
+    auto const files = detail::collectFiles(folder, extension, recursive);
+    if (files.empty()) {
+        return;
+    }
+    detail::load(cache, files, progress);
+}
+
 } // namespace PreloadHelper
 } // namespace jt
 
@@ -1,12 +1,8 @@
 #ifndef JAMTEMPLATE_BUBBLE_SMOKE_HPP
 #define JAMTEMPLATE_BUBBLE_SMOKE_HPP
 
-#include "ease/ease_from_points.hpp"
 #include <game_object.hpp>
-#include <particle_system.hpp>
-#include <shape.hpp>
-#include <tween_collection.hpp>
-#include <tweens/tween_base.hpp>
+#include <particle_batch.hpp>
 
 namespace jt {
 /// A smoke screen effect
@@ -21,10 +17,7 @@ private:
     void doUpdate(float const elapsed) override;
     void doDraw() const override;
 
-    void addTween(std::shared_ptr<jt::TweenInterface> tween);
-
-    std::shared_ptr<jt::ParticleSystem<jt::Shape, 100>> m_particles { nullptr };
-    jt::TweenCollection m_tweens;
+    std::shared_ptr<jt::ParticleBatch<100>> m_particles { nullptr };
 
     float m_fireTimer { 0.0f };
 
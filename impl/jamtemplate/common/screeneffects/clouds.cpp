@@ -1,83 +1,72 @@
 #include "clouds.hpp"
 #include <game_interface.hpp>
-#include <sprite.hpp>
-#include <iostream>
+#include <tiled_sprite.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
 
-jt::Clouds::Clouds(jt::Vector2f const& velocity)
-    : m_velocity { velocity }
-{
-}
+namespace {
 
-void jt::Clouds::doCreate()
-{
-    m_layer1 = std::make_shared<jt::Sprite>("assets/clouds1.png", textureManager());
-    m_layer1->setColor(jt::Color { 255, 255, 255, 110 });
-    m_layer1->setBlendMode(jt::BlendMode::ALPHA);
+constexpr std::array<float, 3> layerSpeedFactors { 1.12f, 2.3f, 3.7f };
 
-    m_layer2 = std::make_shared<jt::Sprite>("assets/clouds2.png", textureManager());
-    m_layer2->setColor(jt::Color { 255, 255, 255, 90 });
-    m_layer2->setBlendMode(jt::BlendMode::ALPHA);
+float wrapPosition(float position, float size)
+{
+    if (size <= 0.0f) [[unlikely]] {
+        return position;
+    }
+    return std::fmod(position, size);
+}
 
-    m_layer3 = std::make_shared<jt::Sprite>("assets/clouds3.png", textureManager());
-    m_layer3->setColor(jt::Color { 255, 255, 255, 100 });
+} // namespace
 
-    m_layer3->setBlendMode(jt::BlendMode::ALPHA);
+jt::Clouds::Clouds(jt::Vector2f const& velocity)
+    : m_velocity { velocity }
+{
 }
 
-void wrapLayerPosition(std::shared_ptr<jt::Sprite>& layer)
+void jt::Clouds::doCreate()
 {
-    auto bounds = layer->getGlobalBounds();
+    auto& gfx = getGame()->gfx();
+    auto const screenSize = gfx.window().getSize() / gfx.camera().getZoom();
 
-    if (bounds.left + layer->getStaticCamOffset().x <= -bounds.width) {
-        layer->setPosition(jt::Vector2f { bounds.left + bounds.width, bounds.top });
-    } else if (bounds.left + layer->getStaticCamOffset().x > bounds.width) {
-        layer->setPosition(jt::Vector2f { bounds.left - bounds.width, bounds.top });
-    }
+    std::array<std::string, 3> const fileNames {
+        "assets/clouds1.png", "assets/clouds2.png", "assets/clouds3.png"
+    };
+    std::array<std::uint8_t, 3> const alphas { 110u, 90u, 100u };
 
-    if (bounds.top + layer->getStaticCamOffset().y <= -bounds.height) {
-        layer->setPosition(jt::Vector2f { bounds.left, bounds.top + bounds.height });
-    } else if (bounds.top + layer->getStaticCamOffset().y > bounds.height) {
-        layer->setPosition(jt::Vector2f { bounds.left, bounds.top - bounds.height });
+    for (auto i = 0u; i != m_layers.size(); ++i) {
+        // one tiled sprite covers the whole screen, the scroll offset moves the clouds
+        auto layer = std::make_shared<jt::TiledSprite>(fileNames[i], screenSize, textureManager());
+        layer->setColor(jt::Color { 255, 255, 255, alphas[i] });
+        layer->setBlendMode(jt::BlendMode::ALPHA);
+        layer->setIgnoreCamMovement(true);
+        m_layers[i] = layer;
     }
 }
 
 void jt::Clouds::doUpdate(float const elapsed)
 {
-    m_layer1->setPosition(m_layer1->getPosition() + m_velocity * elapsed * 1.12f);
-    m_layer2->setPosition(m_layer2->getPosition() + m_velocity * elapsed * 2.3f);
-    m_layer3->setPosition(m_layer3->getPosition() + m_velocity * elapsed * 3.7f);
-
-    wrapLayerPosition(m_layer1);
-    wrapLayerPosition(m_layer2);
-    wrapLayerPosition(m_layer3);
-
-    m_layer1->update(elapsed);
-    m_layer2->update(elapsed);
-    m_layer3->update(elapsed);
-}
-
-void drawLayer(std::shared_ptr<jt::RenderTargetInterface> rt, std::shared_ptr<jt::Sprite> layer)
-{
-    auto const oldPos = layer->getPosition();
-    for (auto j = -1; j != 2; ++j) {
-        for (auto i = -1; i != 2; ++i) {
-            layer->setPosition(oldPos
-                + jt::Vector2f {
-                    i * layer->getGlobalBounds().width, j * layer->getGlobalBounds().height });
-            layer->update(0.0f);
-            layer->draw(rt);
-        }
+    for (auto i = 0u; i != m_layers.size(); ++i) {
+        auto const textureSize = m_layers[i]->getTextureSize();
+        auto& position = m_layerPositions[i];
+        position += m_velocity * elapsed * layerSpeedFactors[i];
+        position.x = wrapPosition(position.x, textureSize.x);
+        position.y = wrapPosition(position.y, textureSize.y);
+        m_layers[i]->update(elapsed);
     }
-    layer->setPosition(oldPos);
-    layer->update(0.0f);
 }
 
 void jt::Clouds::doDraw() const
 {
-    if (m_enabled) {
-        drawLayer(renderTarget(), m_layer1);
-        drawLayer(renderTarget(), m_layer2);
-        drawLayer(renderTarget(), m_layer3);
+    if (!m_enabled) {
+        return;
+    }
+    for (auto i = 0u; i != m_layers.size(); ++i) {
+        // the clouds move with the camera, so the texture coordinate in the top left corner of the
+        // screen depends on the cloud position and the current cam offset.
+        m_layers[i]->setScrollOffset(
+            -1.0f * (m_layerPositions[i] + jt::DrawableImpl::getStaticCamOffset()));
+        m_layers[i]->draw(renderTarget());
     }
 }
 
@@ -85,7 +74,7 @@ void jt::Clouds::setEnabled(bool enabled) { m_enabled = enabled; }
 
 void jt::Clouds::setZ(int zLayer)
 {
-    m_layer1->setZ(zLayer);
-    m_layer2->setZ(zLayer);
-    m_layer3->setZ(zLayer);
+    for (auto& layer : m_layers) {
+        layer->setZ(zLayer);
+    }
 }
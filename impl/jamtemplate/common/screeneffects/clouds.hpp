@@ -3,12 +3,12 @@
 
 #include <game_object.hpp>
 #include <vector.hpp>
+#include <array>
+#include <memory>
 
 namespace jt {
 
-class Sprite;
-
-// TODO extract into screen wrapping sprite group
+class TiledSprite;
 
 /// A overlay of clouds that move with a given velocity as a screen effect
 class Clouds : public jt::GameObject {
@@ -25,9 +25,8 @@ public:
     void setZ(int zLayer);
 
 private:
-    mutable std::shared_ptr<jt::Sprite> m_layer1;
-    mutable std::shared_ptr<jt::Sprite> m_layer2;
-    mutable std::shared_ptr<jt::Sprite> m_layer3;
+    std::array<std::shared_ptr<jt::TiledSprite>, 3> m_layers {};
+    std::array<jt::Vector2f, 3> m_layerPositions {};
 
     jt::Vector2f m_velocity;
 
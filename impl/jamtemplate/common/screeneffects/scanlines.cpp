@@ -13,16 +13,19 @@ void jt::ScanLines::doCreate()
 {
     m_shape = jt::dh::createShapeRect(m_shapeSize, jt::Color { 0, 0, 0, 40 }, textureManager());
     m_shape->setIgnoreCamMovement(true);
+
+    m_shapePositions.clear();
+    for (auto i = 0u; i != m_shapeCount; ++i) {
+        m_shapePositions.push_back(jt::Vector2f { 0.0f, i * 2 * m_shapeSize.y });
+    }
 }
 
+void jt::ScanLines::doUpdate(float const elapsed) { m_shape->update(elapsed); }
+
 void jt::ScanLines::doDraw() const
 {
     if (m_enabled) {
-        for (auto i = 0u; i != m_shapeCount; ++i) {
-            m_shape->setPosition(jt::Vector2f { 0.0f, i * 2 * m_shapeSize.y });
-            m_shape->update(0.1f);
-            m_shape->draw(renderTarget());
-        }
+        m_shape->drawInstances(renderTarget(), m_shapePositions);
     }
 }
 
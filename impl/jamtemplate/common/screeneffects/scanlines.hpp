@@ -5,6 +5,7 @@
 #include <game_object.hpp>
 #include <vector.hpp>
 #include <memory>
+#include <vector>
 
 namespace jt {
 
@@ -25,8 +26,10 @@ private:
     mutable std::shared_ptr<jt::Shape> m_shape;
     jt::Vector2f m_shapeSize;
     std::size_t m_shapeCount;
+    std::vector<jt::Vector2f> m_shapePositions {};
 
     void doCreate() override;
+    void doUpdate(float const elapsed) override;
     void doDraw() const override;
 };
 
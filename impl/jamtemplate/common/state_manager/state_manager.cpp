@@ -35,8 +35,15 @@ void jt::StateManager::switchToStoredState(std::string const& identifier)
 
 void jt::StateManager::doSwitchState(std::weak_ptr<jt::GameInterface> gameInstance)
 {
+    std::shared_ptr<GameInterface> g = gameInstance.lock();
+    if (g) {
+        // cached z layers of the previous state must not show up in the next state
+        auto const target = g->gfx().target();
+        if (target) {
+            target->resetLayers();
+        }
+    }
     if (!m_nextState->hasBeenInitialized()) {
-        std::shared_ptr<GameInterface> g = gameInstance.lock();
         if (g) {
             g->reset();
         }
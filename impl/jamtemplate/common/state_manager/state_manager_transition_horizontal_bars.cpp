@@ -12,23 +12,23 @@ jt::StateManagerTransitionHorizontalBars::StateManagerTransitionHorizontalBars(
     m_shape->setIgnoreCamMovement(true);
 }
 
-void jt::StateManagerTransitionHorizontalBars::doUpdate(float /*elapsed*/) { }
+void jt::StateManagerTransitionHorizontalBars::doUpdate(float elapsed) { m_shape->update(elapsed); }
 void jt::StateManagerTransitionHorizontalBars::doStart() { }
 void jt::StateManagerTransitionHorizontalBars::doDraw(
     std::shared_ptr<jt::RenderTargetInterface> rt)
 {
+    m_shapePositions.clear();
     for (auto i = 0; i != m_numberOfShapes; ++i) {
 
         float const posY = i * m_shape->getLocalBounds().height;
 
         if (i % 2 == 0) {
             float const posX = (getRatio() - 1) * m_shape->getLocalBounds().width;
-            m_shape->setPosition(jt::Vector2f { posX, posY });
+            m_shapePositions.push_back(jt::Vector2f { posX, posY });
         } else {
             float const posX = (1 - getRatio()) * m_shape->getLocalBounds().width;
-            m_shape->setPosition(jt::Vector2f { posX, posY });
+            m_shapePositions.push_back(jt::Vector2f { posX, posY });
         }
-        m_shape->update(0.01f);
-        m_shape->draw(rt);
     }
+    m_shape->drawInstances(rt, m_shapePositions);
 }
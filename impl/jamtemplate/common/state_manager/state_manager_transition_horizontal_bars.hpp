@@ -4,6 +4,7 @@
 #include <shape.hpp>
 #include <state_manager/state_manager_transition_impl.hpp>
 #include <vector.hpp>
+#include <vector>
 
 namespace jt {
 
@@ -21,6 +22,7 @@ private:
 
     std::shared_ptr<jt::Shape> m_shape { nullptr };
     int m_numberOfShapes { 0 };
+    std::vector<jt::Vector2f> m_shapePositions {};
 };
 
 } // namespace jt
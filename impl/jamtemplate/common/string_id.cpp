@@ -0,0 +1,22 @@
+#include "string_id.hpp"
+
+#ifdef JT_ENABLE_STRING_ID_CHECKS
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+void jt::detail::checkStringIdCollision(std::uint64_t hash, std::string_view name) noexcept
+{
+    // never destroyed, so ids can still be created while other static objects are destroyed
+    static auto* const mutex = new std::mutex {};
+    static auto* const names = new std::unordered_map<std::uint64_t, std::string> {};
+
+    std::scoped_lock const lock { *mutex };
+    auto const [it, inserted] = names->try_emplace(hash, name);
+    if (!inserted && it->second != name) [[unlikely]] {
+        std::cerr << "StringId hash collision: '" << it->second << "' and '" << name << "'\n";
+        assert(false && "StringId hash collision");
+    }
+}
+#endif
@@ -0,0 +1,91 @@
+#ifndef JAMTEMPLATE_STRING_ID_HPP
+#define JAMTEMPLATE_STRING_ID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace jt {
+
+constexpr std::uint64_t fnvOffsetBasis { 14695981039346656037ull };
+constexpr std::uint64_t fnvPrime { 1099511628211ull };
+
+/// 64 bit FNV-1a hash
+/// \param str the data to hash
+/// \param hash hash of the preceding data, to hash data in chunks
+/// \return the hash value
+constexpr std::uint64_t fnv1a(std::string_view str, std::uint64_t hash = fnvOffsetBasis) noexcept
+{
+    for (auto const c : str) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+#ifdef JT_ENABLE_STRING_ID_CHECKS
+namespace detail {
+/// Remember the name of a hash and assert that no other name has the same hash
+/// \param hash the hash
+/// \param name the name
+void checkStringIdCollision(std::uint64_t hash, std::string_view name) noexcept;
+} // namespace detail
+#endif
+
+/// Hashed identifier, e.g. for texture or animation names. Comparing and ordering StringIds only
+/// compares the hash values, so they are cheap keys for maps used every frame. The name itself is
+/// not stored. Ids of literals can be created at compile time via the _sid literal. With
+/// JT_ENABLE_STRING_ID_CHECKS, all ids created at runtime are checked for hash collisions. The
+/// check locks a mutex for every id, so it is off by default.
+class StringId {
+public:
+    constexpr StringId() noexcept = default;
+
+    /// \param str the name to hash
+    constexpr StringId(std::string_view str) noexcept
+        : m_hash { fnv1a(str) }
+    {
+#ifdef JT_ENABLE_STRING_ID_CHECKS
+        if (!std::is_constant_evaluated()) {
+            detail::checkStringIdCollision(m_hash, str);
+        }
+#endif
+    }
+    constexpr StringId(std::string const& str) noexcept
+        : StringId { std::string_view { str } }
+    {
+    }
+    constexpr StringId(char const* str) noexcept
+        : StringId { std::string_view { str } }
+    {
+    }
+
+    constexpr std::uint64_t getHash() const noexcept { return m_hash; }
+
+    constexpr auto operator<=>(StringId const& other) const noexcept = default;
+
+private:
+    std::uint64_t m_hash { fnvOffsetBasis };
+};
+
+namespace literals {
+consteval StringId operator""_sid(char const* str, std::size_t size)
+{
+    return StringId { std::string_view { str, size } };
+}
+} // namespace literals
+
+} // namespace jt
+
+template <>
+struct std::hash<jt::StringId> {
+    std::size_t operator()(jt::StringId const& id) const noexcept
+    {
+        return static_cast<std::size_t>(id.getHash());
+    }
+};
+
+#endif // JAMTEMPLATE_STRING_ID_HPP
@@ -0,0 +1,150 @@
+#include "strip_sprite.hpp"
+#include <sprite.hpp>
+#include <stdexcept>
+
+jt::StripSprite::StripSprite(std::string const& start, std::string const& middle,
+    std::string const& end, jt::Vector2u const& size, bool horizontal,
+    jt::TextureManagerInterface& textureManager)
+    : m_start { start }
+    , m_middle { middle }
+    , m_end { end }
+    , m_horizontal { horizontal }
+{
+    for (auto const& fileName : { m_start, m_middle, m_end }) {
+        if (fileName.empty() || fileName.find('#') != std::string::npos) {
+            throw std::invalid_argument { "invalid strip piece file name '" + fileName + "'" };
+        }
+    }
+    setSize(size, textureManager);
+}
+
+void jt::StripSprite::setSize(
+    jt::Vector2u const& size, jt::TextureManagerInterface& textureManager)
+{
+    if (size.x == 0u || size.y == 0u) {
+        throw std::invalid_argument { "strip size must not be zero" };
+    }
+    if (m_sprite && size == m_size) {
+        return;
+    }
+
+    auto sprite = std::make_shared<jt::Sprite>(getTextureName(size), textureManager);
+    if (m_sprite) {
+        // take over all properties from the sprite of the old size
+        sprite->setColor(m_sprite->getColor());
+        sprite->setScale(m_sprite->getScale());
+        sprite->setRotation(getRotation());
+        sprite->setOrigin(getOrigin());
+        sprite->setShadow(getShadowColor(), getShadowOffset());
+        sprite->setShadowActive(getShadowActive());
+        sprite->setOutline(getOutlineColor(), getOutlineWidth());
+    }
+    sprite->setPosition(m_position + getShakeOffset() + getOffset());
+    sprite->setIgnoreCamMovement(getIgnoreCamMovement());
+    sprite->setCamMovementFactor(getCamMovementFactor());
+    m_sprite = sprite;
+    m_size = size;
+    markContentChanged();
+}
+
+jt::Vector2u jt::StripSprite::getSize() const { return m_size; }
+
+std::string jt::StripSprite::getTextureName(jt::Vector2u const& size) const
+{
+    return std::string { "#s#" } + (m_horizontal ? "h" : "v") + "#" + m_start + "#" + m_middle
+        + "#" + m_end + "#" + std::to_string(size.x) + "#" + std::to_string(size.y);
+}
+
+void jt::StripSprite::setColor(jt::Color const& col) { m_sprite->setColor(col); }
+
+jt::Color jt::StripSprite::getColor() const { return m_sprite->getColor(); }
+
+void jt::StripSprite::setPosition(jt::Vector2f const& pos)
+{
+    if (pos == m_position) {
+        return;
+    }
+    m_position = pos;
+    // forwarded immediately, so positions set after update() are drawn correctly
+    m_sprite->setPosition(m_position + getShakeOffset() + getOffset());
+    markContentChanged();
+}
+
+jt::Vector2f jt::StripSprite::getPosition() const { return m_position; }
+
+jt::Rectf jt::StripSprite::getGlobalBounds() const { return m_sprite->getGlobalBounds(); }
+
+jt::Rectf jt::StripSprite::getLocalBounds() const { return m_sprite->getLocalBounds(); }
+
+void jt::StripSprite::setScale(jt::Vector2f const& scale) { m_sprite->setScale(scale); }
+
+jt::Vector2f jt::StripSprite::getScale() const { return m_sprite->getScale(); }
+
+void jt::StripSprite::setShadowActive(bool active)
+{
+    DrawableImpl::setShadowActive(active);
+    m_sprite->setShadowActive(active);
+}
+
+void jt::StripSprite::setShadow(jt::Color const& color, jt::Vector2f const& offset)
+{
+    DrawableImpl::setShadow(color, offset);
+    m_sprite->setShadow(color, offset);
+}
+
+void jt::StripSprite::setOutline(jt::Color const& color, int width)
+{
+    DrawableImpl::setOutline(color, width);
+    m_sprite->setOutline(color, width);
+}
+
+void jt::StripSprite::setIgnoreCamMovement(bool ignore)
+{
+    DrawableImpl::setIgnoreCamMovement(ignore);
+    m_sprite->setIgnoreCamMovement(ignore);
+}
+
+void jt::StripSprite::setCamMovementFactor(float factor)
+{
+    DrawableImpl::setCamMovementFactor(factor);
+    m_sprite->setCamMovementFactor(factor);
+}
+
+void jt::StripSprite::doUpdate(float elapsed)
+{
+    m_sprite->setPosition(m_position + getShakeOffset() + getOffset());
+    m_sprite->update(elapsed);
+}
+
+void jt::StripSprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    // shake and offset can change after update()
+    m_sprite->setPosition(m_position + getShakeOffset() + getOffset());
+    m_sprite->setBlendMode(getBlendMode());
+    m_sprite->draw(sptr);
+}
+
+// shadow, outline and flash are drawn by the sprite
+void jt::StripSprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const { }
+
+void jt::StripSprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const
+{
+}
+
+void jt::StripSprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const
+{
+}
+
+void jt::StripSprite::doRotate(float rot) { m_sprite->setRotation(rot); }
+
+void jt::StripSprite::doFlashImpl(float t, jt::Color col) { m_sprite->flash(t, col); }
+
+// the composed texture is drawn as a sprite, which uses the render queue
+bool jt::StripSprite::usesRenderQueue() const { return true; }
+
+void jt::StripSprite::setOriginInternal(jt::Vector2f const& origin)
+{
+    if (m_sprite) {
+        m_sprite->setOrigin(origin);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef JAMTEMPLATE_STRIP_SPRITE_HPP
+#define JAMTEMPLATE_STRIP_SPRITE_HPP
+
+#include <graphics/drawable_impl.hpp>
+#include <vector.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+class Sprite;
+class TextureManagerInterface;
+
+/// Drawable composed of a start piece, a repeated middle piece and an end piece, e.g. for
+/// platforms or frames of variable size. The pieces are composed into one texture per size, which
+/// is cached in the texture manager, so drawing costs the same as a single sprite.
+class StripSprite : public jt::DrawableImpl {
+public:
+    using Sptr = std::shared_ptr<StripSprite>;
+
+    /// Constructor
+    /// \param start file name of the piece at the left (horizontal) or top (vertical)
+    /// \param middle file name of the piece repeated between start and end
+    /// \param end file name of the piece at the right (horizontal) or bottom (vertical)
+    /// \param size size of the strip in pixel. If larger than the pieces, rows (horizontal) or
+    /// columns (vertical) are repeated.
+    /// \param horizontal if true, pieces are placed left to right, otherwise top to bottom
+    /// \param textureManager the texture manager
+    StripSprite(std::string const& start, std::string const& middle, std::string const& end,
+        jt::Vector2u const& size, bool horizontal, jt::TextureManagerInterface& textureManager);
+
+    /// Set the size of the strip. The texture is only composed if the size changes and no
+    /// texture of that size has been composed before.
+    /// \param size size in pixel
+    /// \param textureManager the texture manager
+    void setSize(jt::Vector2u const& size, jt::TextureManagerInterface& textureManager);
+
+    /// Get the size of the strip
+    /// \return size in pixel
+    jt::Vector2u getSize() const;
+
+    void setColor(jt::Color const& col) override;
+    jt::Color getColor() const override;
+
+    void setPosition(jt::Vector2f const& pos) override;
+    jt::Vector2f getPosition() const override;
+
+    jt::Rectf getGlobalBounds() const override;
+    jt::Rectf getLocalBounds() const override;
+
+    void setScale(jt::Vector2f const& scale) override;
+    jt::Vector2f getScale() const override;
+
+    void setShadowActive(bool active) override;
+    void setShadow(jt::Color const& color, jt::Vector2f const& offset) override;
+    void setOutline(jt::Color const& color, int width) override;
+
+    void setIgnoreCamMovement(bool ignore) override;
+    void setCamMovementFactor(float factor) override;
+
+private:
+    std::string m_start;
+    std::string m_middle;
+    std::string m_end;
+    bool m_horizontal;
+
+    jt::Vector2u m_size { 0u, 0u };
+    jt::Vector2f m_position { 0.0f, 0.0f };
+
+    std::shared_ptr<jt::Sprite> m_sprite { nullptr };
+
+    std::string getTextureName(jt::Vector2u const& size) const;
+
+    void doUpdate(float elapsed) override;
+    void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doRotate(float rot) override;
+    void doFlashImpl(float t, jt::Color col) override;
+
+    bool usesRenderQueue() const override;
+    void setOriginInternal(jt::Vector2f const& origin) override;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_STRIP_SPRITE_HPP
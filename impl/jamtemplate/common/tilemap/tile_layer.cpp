@@ -37,7 +37,8 @@ jt::tilemap::TileLayer::TileLayer(std::tuple<std::vector<jt::tilemap::TileInfo>
 
 bool jt::tilemap::TileLayer::isTileVisible(jt::tilemap::TileInfo const& tile) const
 {
-    if (m_screenSizeHint.x == 0 && m_screenSizeHint.y == 0) {
+    auto const viewSize = getCullingViewSize();
+    if (viewSize.x == 0 && viewSize.y == 0) {
         return true;
     }
 
@@ -48,10 +49,10 @@ bool jt::tilemap::TileLayer::isTileVisible(jt::tilemap::TileInfo const& tile) co
     if (tile.position.y + camOffset.y + tile.size.y < 0) {
         return false;
     }
-    if (tile.position.x + camOffset.x >= m_screenSizeHint.x + tile.size.x) {
+    if (tile.position.x + camOffset.x >= viewSize.x + tile.size.x) {
         return false;
     }
-    if (tile.position.y + camOffset.y >= m_screenSizeHint.y + tile.size.y) {
+    if (tile.position.y + camOffset.y >= viewSize.y + tile.size.y) {
         return false;
     }
     return true;
@@ -75,7 +76,6 @@ void jt::tilemap::TileLayer::doDraw(std::shared_ptr<jt::RenderTargetLayer> const
         }
         m_tileSetSprites.at(id)->setColor(color);
         m_tileSetSprites.at(id)->setScale(m_scale);
-        m_tileSetSprites.at(id)->update(0.0f);
         m_tileSetSprites.at(id)->setBlendMode(getBlendMode());
         m_tileSetSprites.at(id)->draw(sptr);
     }
@@ -98,6 +98,9 @@ void jt::tilemap::TileLayer::doDrawOutline(
     // Nothing to do
 }
 
+// tiles are drawn as sprites, which use the render queue
+bool jt::tilemap::TileLayer::usesRenderQueue() const { return true; }
+
 void jt::tilemap::TileLayer::doUpdate(float /*elapsed*/) { }
 
 void jt::tilemap::TileLayer::setColor(jt::Color const& col)
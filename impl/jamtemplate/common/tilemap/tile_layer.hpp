@@ -44,6 +44,8 @@ public:
 private:
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
 
+    bool usesRenderQueue() const override;
+
 public:
     void doUpdate(float elapsed) override;
 
@@ -1,22 +1,35 @@
 #include "tilemap_cache.hpp"
+#include <asset_pack/virtual_file_system.hpp>
 #include <tracy/Tracy.hpp>
 #include <iostream>
 
 std::shared_ptr<tson::Map> jt::TilemapCache::get(std::string const& fileName) const
 {
     ZoneScopedN("jt::TilemapCache::get");
-    if (!m_maps.contains(fileName)) {
-        tson::Tileson parser;
-
-        auto map = parser.parse(fileName);
-        if (map->getStatus() != tson::ParseStatus::OK) {
-            std::cerr << "tilemap json could not be parsed: '" << fileName << std::endl;
-            throw std::invalid_argument { "tilemap json could not be parsed." };
+    {
+        std::scoped_lock const lock { m_mutex };
+        if (auto const it = m_maps.find(fileName); it != m_maps.cend()) {
+            return it->second;
         }
-        m_maps[fileName] = std::move(map);
     }
 
-    return m_maps.at(fileName);
+    // parse without holding the lock, so different maps can be parsed in parallel
+    tson::Tileson parser;
+    // packed maps are parsed directly from the mapped pack data
+    auto const packed = jt::VirtualFileSystem::findInPack(fileName);
+    auto map = packed ? parser.parse(packed->data(), packed->size()) : parser.parse(fileName);
+    if (map->getStatus() != tson::ParseStatus::OK) {
+        std::cerr << "tilemap json could not be parsed: '" << fileName << std::endl;
+        throw std::invalid_argument { "tilemap json could not be parsed." };
+    }
+
+    std::scoped_lock const lock { m_mutex };
+    // if another thread parsed the same map in the meantime, its map is kept
+    return m_maps.try_emplace(fileName, std::move(map)).first->second;
 }
 
-std::size_t jt::TilemapCache::getNumberOfMaps() const { return m_maps.size(); }
+std::size_t jt::TilemapCache::getNumberOfMaps() const
+{
+    std::scoped_lock const lock { m_mutex };
+    return m_maps.size();
+}
@@ -2,14 +2,21 @@
 #define JAMTEMPLATE_TILEMAP_CACHE_HPP
 
 #include <tilemap/tilemap_cache_interface.hpp>
+#include <map>
+#include <mutex>
 
 namespace jt {
+/// Thread safe cache of parsed tilemaps, maps can be loaded from multiple threads in parallel.
 class TilemapCache : public jt::TilemapCacheInterface {
 public:
+    /// get() locks a mutex, so maps can be preloaded from multiple threads
+    static constexpr bool isThreadSafe { true };
+
     std::shared_ptr<tson::Map> get(std::string const& fileName) const override;
     std::size_t getNumberOfMaps() const;
 
 private:
+    mutable std::mutex m_mutex;
     mutable std::map<std::string, std::shared_ptr<tson::Map>> m_maps;
 };
 } // namespace jt
@@ -10,6 +10,8 @@ namespace jt {
 class TilemapCacheInterface {
 public:
     /// get map for a filename. This function is expected to cache the respective tson data.
+    /// Implementations which can be called from multiple threads in parallel declare
+    /// `static constexpr bool isThreadSafe { true }`, so maps can be preloaded on worker threads.
     /// \param fileName map file to be loaded
     /// \return the tson map
     virtual std::shared_ptr<tson::Map> get(std::string const& fileName) const = 0;
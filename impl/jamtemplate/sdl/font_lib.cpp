@@ -0,0 +1,22 @@
+#include "font_lib.hpp"
+#include <iostream>
+
+std::shared_ptr<jt::FontLib> jt::loadFontLib(std::string const& fontFileName,
+    unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    if (!renderTarget) {
+        std::cout << "no valid render target in loadFontLib" << std::endl;
+        return nullptr;
+    }
+
+    auto font = std::shared_ptr<TTF_Font>(
+        TTF_OpenFont(fontFileName.c_str(), static_cast<int>(characterSize)),
+        [](TTF_Font* f) { TTF_CloseFont(f); });
+    if (!font) {
+        std::cerr << "cannot load font: " << fontFileName << std::endl
+                  << "error message: " << TTF_GetError() << std::endl;
+        return nullptr;
+    }
+
+    return std::make_shared<jt::GlyphAtlas>(font, renderTarget);
+}
@@ -0,0 +1,23 @@
+#ifndef JAMTEMPLATE_FONT_LIB_HPP
+#define JAMTEMPLATE_FONT_LIB_HPP
+
+#include <glyph_atlas.hpp>
+#include <render_target_layer.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+using FontLib = jt::GlyphAtlas;
+
+/// Open a font and rasterize it into a glyph atlas
+/// \param fontFileName path to the font (ttf)
+/// \param characterSize character size
+/// \param renderTarget the render target the atlas texture is created for
+/// \return the glyph atlas, nullptr if the font could not be loaded
+std::shared_ptr<jt::FontLib> loadFontLib(std::string const& fontFileName,
+    unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget);
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_FONT_LIB_HPP
@@ -1,8 +1,16 @@
 #include "gfx_impl.hpp"
+#include <graphics/drawable_impl.hpp>
 #include <render_target_lib.hpp>
+#include <stdexcept>
+#include <string>
 
 namespace jt {
 
+namespace {
+// time per frame spent on uploading prefetched textures, so loading does not cause hitches
+constexpr float textureUploadBudget { 0.002f };
+} // namespace
+
 GfxImpl::GfxImpl(RenderWindowInterface& window, CamInterface& cam)
     : m_window { window }
     , m_camera { cam }
@@ -20,6 +28,19 @@ GfxImpl::GfxImpl(RenderWindowInterface& window, CamInterface& cam)
     GfxImpl::createZLayer(0);
 
     m_textureManager = TextureManagerImpl { m_target->get(0) };
+
+    m_renderQueue = std::make_shared<jt::RenderQueue>();
+    DrawableImpl::setRenderQueue(m_renderQueue);
+    DrawableImpl::setStaticRenderTarget(m_target);
+    DrawableImpl::setStaticViewSize(jt::Vector2f { static_cast<float>(scaledWidth),
+        static_cast<float>(scaledHeight) });
+}
+
+GfxImpl::~GfxImpl()
+{
+    DrawableImpl::setRenderQueue(nullptr);
+    DrawableImpl::setStaticRenderTarget({});
+    DrawableImpl::setStaticViewSize(jt::Vector2f { 0.0f, 0.0f });
 }
 
 RenderWindowInterface& GfxImpl::window() { return m_window; }
@@ -35,32 +56,53 @@ void GfxImpl::reset() { m_camera.reset(); }
 void GfxImpl::update(float elapsed)
 {
     m_camera.update(elapsed);
-    DrawableImpl::setCamOffset(-1.0f * m_camera.getCamOffset());
+    auto const camOffset = -1.0f * m_camera.getCamOffset();
+    if (camOffset != DrawableImpl::getStaticCamOffset()) {
+        // cached layers show the world at the old camera position
+        m_target->invalidateCamLayers();
+    }
+    DrawableImpl::setCamOffset(camOffset);
+
+    m_textureManager->uploadPrefetched(textureUploadBudget);
+    m_textureManager->evictUnused();
 }
 
 void GfxImpl::clear() { m_target->clearPixels(); }
 
 void GfxImpl::display()
 {
+    m_renderQueue->flush();
+
     // Detach the texture
     SDL_SetRenderTarget(m_target->m_renderer.get(), nullptr);
     SDL_RenderClear(m_target->m_renderer.get());
 
+    SDL_Rect const sourceRect { m_srcRect.left, m_srcRect.top, m_srcRect.width, m_srcRect.height };
+    SDL_Rect const destRect { static_cast<int>(m_camera.getShakeOffset().x),
+        static_cast<int>(m_camera.getShakeOffset().y), m_destRect.width, m_destRect.height };
+
+    // Now render the textures to our screen
+    bool first { true };
     for (auto& kvp : m_target->m_textures) {
-        // Now render the textures to our screen
-
-        SDL_Rect sourceRect { m_srcRect.left, m_srcRect.top, m_srcRect.width, m_srcRect.height };
-        SDL_Rect destRect { static_cast<int>(m_camera.getShakeOffset().x),
-            static_cast<int>(m_camera.getShakeOffset().y), m_destRect.width, m_destRect.height };
-        SDL_RenderCopyEx(m_target->m_renderer.get(), kvp.second.get(), &sourceRect, &destRect, 0,
-            nullptr, SDL_FLIP_NONE);
-        m_window.display();
-        SDL_RenderPresent(m_target->m_renderer.get());
+        // Layers without draws this frame are fully transparent, unless they are cached. The
+        // lowest layer is always drawn, as it provides the opaque background.
+        if (first || m_target->hasContent(kvp.first)) {
+            SDL_RenderCopy(m_target->m_renderer.get(), kvp.second.get(), &sourceRect, &destRect);
+        }
+        first = false;
     }
+
+    // gui is rendered on top of all layers, then the frame is presented once
+    m_window.display();
+    SDL_RenderPresent(m_target->m_renderer.get());
 }
 
 void GfxImpl::createZLayer(int z)
 {
+    if (m_target->m_textures.contains(z)) {
+        // keep the existing texture, e.g. when a state creates its layers again
+        return;
+    }
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     auto const texture = std::shared_ptr<SDL_Texture>(
         SDL_CreateTexture(m_target->m_renderer.get(), SDL_PIXELFORMAT_RGBA8888,
@@ -71,4 +113,14 @@ void GfxImpl::createZLayer(int z)
     m_target->add(z, texture);
 }
 
+void GfxImpl::setZLayerSorted(int z, bool sorted)
+{
+    auto const it = m_target->m_textures.find(z);
+    if (it == m_target->m_textures.cend()) {
+        throw std::invalid_argument { "setZLayerSorted called for z layer " + std::to_string(z)
+            + " which was not created" };
+    }
+    m_renderQueue->setTargetSorted(it->second.get(), sorted);
+}
+
 } // namespace jt
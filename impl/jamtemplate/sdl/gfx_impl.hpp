@@ -3,6 +3,7 @@
 
 #include <cam_interface.hpp>
 #include <graphics/gfx_interface.hpp>
+#include <graphics/render_queue.hpp>
 #include <graphics/render_target_interface.hpp>
 #include <graphics/render_window_interface.hpp>
 #include <render_target_layer_lib.hpp>
@@ -16,6 +17,8 @@ namespace jt {
 class GfxImpl : public GfxInterface {
 public:
     GfxImpl(RenderWindowInterface& window, CamInterface& cam);
+    ~GfxImpl() override;
+
     RenderWindowInterface& window() override;
     CamInterface& camera() override;
     std::shared_ptr<jt::RenderTargetInterface> target() override;
@@ -26,12 +29,14 @@ public:
     void display() override;
 
     void createZLayer(int z) override;
+    void setZLayerSorted(int z, bool sorted) override;
 
 private:
     RenderWindowInterface& m_window;
     CamInterface& m_camera;
     std::shared_ptr<jt::RenderTarget> m_target { nullptr };
     std::optional<jt::TextureManagerImpl> m_textureManager;
+    std::shared_ptr<jt::RenderQueue> m_renderQueue { nullptr };
 
     jt::Recti m_srcRect;
     jt::Recti m_destRect;
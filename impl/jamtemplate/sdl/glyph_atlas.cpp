@@ -0,0 +1,102 @@
+#include "glyph_atlas.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace jt {
+
+GlyphAtlas::GlyphAtlas(
+    std::shared_ptr<TTF_Font> font, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+    : m_font { font }
+    , m_renderTarget { renderTarget }
+{
+    m_lineHeight = TTF_FontHeight(m_font.get());
+
+    // render all glyphs on full white, so coloring can be done afterwards
+    SDL_Color const white { 255u, 255u, 255u, 255u };
+    std::array<std::shared_ptr<SDL_Surface>, 256> glyphSurfaces {};
+
+    // shelf packing: glyphs are placed left to right in rows of at most maxWidth pixel
+    constexpr int maxWidth { 512 };
+    constexpr int padding { 1 };
+    int x { 0 };
+    int y { 0 };
+    int rowHeight { 0 };
+    int atlasWidth { 1 };
+    for (auto c = 32u; c != m_glyphs.size(); ++c) {
+        auto const character = static_cast<std::uint16_t>(c);
+        if (!TTF_GlyphIsProvided(m_font.get(), character)) {
+            continue;
+        }
+        auto surface = std::shared_ptr<SDL_Surface>(
+            TTF_RenderGlyph_Solid(m_font.get(), character, white),
+            [](SDL_Surface* s) { SDL_FreeSurface(s); });
+        int advance { 0 };
+        if (!surface
+            || TTF_GlyphMetrics(
+                   m_font.get(), character, nullptr, nullptr, nullptr, nullptr, &advance)
+                != 0) {
+            continue;
+        }
+
+        if (x + surface->w > maxWidth) {
+            x = 0;
+            y += rowHeight + padding;
+            rowHeight = 0;
+        }
+        m_glyphs[c] = Glyph { SDL_Rect { x, y, surface->w, surface->h }, advance };
+        m_hasGlyph[c] = true;
+        glyphSurfaces[c] = surface;
+
+        x += surface->w + padding;
+        rowHeight = std::max(rowHeight, surface->h);
+        atlasWidth = std::max(atlasWidth, x);
+    }
+    auto const atlasHeight = std::max(1, y + rowHeight);
+
+    auto const image = std::shared_ptr<SDL_Surface>(
+        SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    SDL_FillRect(image.get(), nullptr, SDL_MapRGBA(image->format, 0, 0, 0, 0));
+    for (auto c = 0u; c != m_glyphs.size(); ++c) {
+        if (!m_hasGlyph[c]) {
+            continue;
+        }
+        auto destRect = m_glyphs[c].sourceRect;
+        SDL_BlitSurface(glyphSurfaces[c].get(), nullptr, image.get(), &destRect);
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    m_texture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    SDL_SetTextureBlendMode(m_texture.get(), SDL_BLENDMODE_BLEND);
+    m_textureSize
+        = jt::Vector2f { static_cast<float>(atlasWidth), static_cast<float>(atlasHeight) };
+}
+
+GlyphAtlas::Glyph const* GlyphAtlas::getGlyph(char character) const noexcept
+{
+    auto const index = static_cast<unsigned char>(character);
+    if (!m_hasGlyph[index]) {
+        return nullptr;
+    }
+    return &m_glyphs[index];
+}
+
+int GlyphAtlas::getKerning(char previous, char current) const noexcept
+{
+    // TTF_RenderText only applies kerning if it is enabled for the font
+    if (TTF_GetFontKerning(m_font.get()) == 0) {
+        return 0;
+    }
+    return TTF_GetFontKerningSizeGlyphs(m_font.get(), static_cast<unsigned char>(previous),
+        static_cast<unsigned char>(current));
+}
+
+int GlyphAtlas::getLineHeight() const noexcept { return m_lineHeight; }
+
+SDL_Texture* GlyphAtlas::getTexture() const noexcept { return m_texture.get(); }
+
+jt::Vector2f GlyphAtlas::getTextureSize() const noexcept { return m_textureSize; }
+
+} // namespace jt
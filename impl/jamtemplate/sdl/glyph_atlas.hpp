@@ -0,0 +1,66 @@
+#ifndef JAMTEMPLATE_GLYPH_ATLAS_HPP
+#define JAMTEMPLATE_GLYPH_ATLAS_HPP
+
+#include <render_target_layer.hpp>
+#include <sdl_2_include.hpp>
+#include <vector.hpp>
+#include <array>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+/// All glyphs of a font in one character size, rasterized once into a single texture.
+/// Covers the Latin-1 range, which is what SDL_ttf renders for TTF_RenderText.
+class GlyphAtlas {
+public:
+    /// One glyph in the atlas
+    struct Glyph {
+        /// area of the glyph in the atlas texture, the glyph is rendered relative to the line top
+        SDL_Rect sourceRect { 0, 0, 0, 0 };
+        /// horizontal distance to the next glyph in pixel
+        int advance { 0 };
+    };
+
+    /// Constructor, rasterizes all glyphs. Use the font cache to share atlases.
+    /// \param font the font
+    /// \param renderTarget the render target the atlas texture is created for
+    GlyphAtlas(std::shared_ptr<TTF_Font> font, std::shared_ptr<jt::RenderTargetLayer> renderTarget);
+
+    /// Get a glyph
+    /// \param character the character
+    /// \return the glyph, nullptr if the character is not provided by the font
+    Glyph const* getGlyph(char character) const noexcept;
+
+    /// Get the kerning between two consecutive characters, as applied by TTF_RenderText
+    /// \param previous the previous character
+    /// \param current the current character
+    /// \return horizontal adjustment in pixel, added to the advance of the previous glyph
+    int getKerning(char previous, char current) const noexcept;
+
+    /// Get the height of one line of text
+    /// \return line height in pixel
+    int getLineHeight() const noexcept;
+
+    /// Get the atlas texture
+    /// \return the texture
+    SDL_Texture* getTexture() const noexcept;
+
+    /// Get the size of the atlas texture
+    /// \return size in pixel
+    jt::Vector2f getTextureSize() const noexcept;
+
+private:
+    std::shared_ptr<TTF_Font> m_font { nullptr };
+    std::weak_ptr<jt::RenderTargetLayer> m_renderTarget;
+    std::shared_ptr<SDL_Texture> m_texture { nullptr };
+    jt::Vector2f m_textureSize { 0.0f, 0.0f };
+
+    std::array<Glyph, 256> m_glyphs {};
+    std::array<bool, 256> m_hasGlyph {};
+    int m_lineHeight { 0 };
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_GLYPH_ATLAS_HPP
@@ -11,6 +11,8 @@ jt::Line::Line(jt::Vector2f lineVector)
     : m_lineVector { std::move(lineVector) }
     , m_color { jt::colors::White }
 {
+    // lines have no bounds, so they can not be culled
+    setCullingEnabled(false);
 }
 
 void jt::Line::setLineVector(jt::Vector2f const& lineVector) noexcept { m_lineVector = lineVector; }
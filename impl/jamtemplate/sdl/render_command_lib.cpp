@@ -0,0 +1,44 @@
+#include "render_command_lib.hpp"
+
+void const* jt::RenderCommand::getTarget() const noexcept { return target; }
+
+std::uint64_t jt::RenderCommand::getStateKey() const noexcept
+{
+    // textures are identified by their address. Fold it into 40 bit, which is plenty to tell apart
+    // the textures in use at the same time.
+    auto const address = reinterpret_cast<std::uintptr_t>(texture.get());
+    auto const textureKey = (static_cast<std::uint64_t>(address) ^ (address >> 40)) & 0xFFFFFFFFFFu;
+    return (static_cast<std::uint64_t>(blendMode & 0xFFu) << 40u) | textureKey;
+}
+
+void jt::RenderCommand::draw() const
+{
+    SDL_SetRenderDrawBlendMode(renderer, blendMode);
+    SDL_SetTextureColorMod(texture.get(), color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture.get(), color.a);
+    SDL_RenderCopyEx(renderer, texture.get(),
+        sourceRect.has_value() ? &sourceRect.value() : nullptr, &destRect, angle, &center, flip);
+}
+
+void jt::submitRenderCommands(
+    std::vector<RenderCommand> const& commands, std::vector<std::uint32_t> const& order)
+{
+    if (order.empty()) {
+        return;
+    }
+    auto* const renderer = commands[order.front()].renderer;
+    auto* const previousTarget = SDL_GetRenderTarget(renderer);
+    auto* currentTarget = previousTarget;
+    for (auto const idx : order) {
+        auto const& command = commands[idx];
+        // switching render targets flushes SDLs internal batch, so only do it when needed
+        if (command.target != currentTarget) {
+            SDL_SetRenderTarget(command.renderer, command.target);
+            currentTarget = command.target;
+        }
+        command.draw();
+    }
+    if (currentTarget != previousTarget) {
+        SDL_SetRenderTarget(renderer, previousTarget);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
+#define JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
+
+#include <color/color.hpp>
+#include <sdl_2_include.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace jt {
+
+/// One textured quad to be drawn into a ZLayer.
+struct RenderCommand {
+    SDL_Renderer* renderer { nullptr };
+    /// layer texture the command is drawn into. Captured from the renderer when the command is
+    /// created, so commands can be submitted independent of the current render target.
+    SDL_Texture* target { nullptr };
+    /// shared with the drawable, so the texture stays alive until the command is drawn, even if
+    /// the drawable or the texture manager release it in the meantime
+    std::shared_ptr<SDL_Texture> texture { nullptr };
+    /// Source rect in the texture. No value means the whole texture is used.
+    std::optional<SDL_Rect> sourceRect { std::nullopt };
+    SDL_Rect destRect { 0, 0, 0, 0 };
+    double angle { 0.0 };
+    SDL_Point center { 0, 0 };
+    SDL_RendererFlip flip { SDL_FLIP_NONE };
+    jt::Color color { jt::colors::White };
+    SDL_BlendMode blendMode { SDL_BLENDMODE_BLEND };
+
+    /// Get the target the command is drawn into
+    /// \return the target
+    void const* getTarget() const noexcept;
+
+    /// Get the render state (texture and blend mode) packed into the lower 48 bit
+    /// \return the state key
+    std::uint64_t getStateKey() const noexcept;
+
+    /// Draw the command into the current render target of the renderer
+    void draw() const;
+};
+
+/// Draw render commands in the given order, switching render targets as needed.
+/// \param commands the commands
+/// \param order indices into commands
+void submitRenderCommands(
+    std::vector<RenderCommand> const& commands, std::vector<std::uint32_t> const& order);
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
@@ -12,10 +12,49 @@ jt::RenderTarget::RenderTarget(std::shared_ptr<jt::RenderTargetLayer> renderer)
 std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z)
 {
     SDL_SetRenderTarget(m_renderer.get(), m_textures[z].get());
+    m_layerStates.touch(z);
     return m_renderer;
 }
 
-void jt::RenderTarget::add(int z, std::shared_ptr<SDL_Texture> texture) { m_textures[z] = texture; }
+bool jt::RenderTarget::needsRedraw(int z) const { return m_layerStates.needsRedraw(z); }
+
+void jt::RenderTarget::setLayerCached(int z, bool cached) { m_layerStates.setCached(z, cached); }
+
+bool jt::RenderTarget::isLayerCached(int z) const { return m_layerStates.isCached(z); }
+
+void jt::RenderTarget::setLayerIgnoresCamMovement(int z, bool ignore)
+{
+    m_layerStates.setIgnoresCamMovement(z, ignore);
+}
+
+void jt::RenderTarget::resetLayers() { m_layerStates.reset(); }
+
+void jt::RenderTarget::invalidateLayer(int z, jt::Rectf const& rect)
+{
+    if (!m_layerStates.isCached(z)) {
+        // uncached layers are redrawn every frame anyway
+        return;
+    }
+    auto const it = m_textures.find(z);
+    if (it == m_textures.cend()) [[unlikely]] {
+        return;
+    }
+    int w { 0 };
+    int h { 0 };
+    SDL_QueryTexture(it->second.get(), nullptr, nullptr, &w, &h);
+    m_layerStates.invalidate(
+        z, rect, jt::Vector2f { static_cast<float>(w), static_cast<float>(h) });
+}
+
+void jt::RenderTarget::invalidateCamLayers() { m_layerStates.invalidateCamLayers(); }
+
+void jt::RenderTarget::add(int z, std::shared_ptr<SDL_Texture> texture)
+{
+    m_textures[z] = texture;
+    m_layerStates.add(z);
+}
+
+bool jt::RenderTarget::hasContent(int z) const { return m_layerStates.hasContent(z); }
 
 void jt::RenderTarget::clearPixels()
 {
@@ -24,6 +63,10 @@ void jt::RenderTarget::clearPixels()
     // render to the small texture first
     bool first { true };
     for (auto& kvp : m_textures) {
+        if (!m_layerStates.beginFrame(kvp.first)) {
+            first = false;
+            continue;
+        }
         SDL_SetRenderTarget(m_renderer.get(), kvp.second.get());
         if (first) {
             SDL_SetTextureAlphaMod(kvp.second.get(), 255);
@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 #define JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 
+#include <graphics/layer_states.hpp>
 #include <graphics/render_target_interface.hpp>
 #include <sdl_2_include.hpp>
 #include <memory>
@@ -11,14 +12,31 @@ class RenderTarget : public RenderTargetInterface {
 public:
     explicit RenderTarget(std::shared_ptr<jt::RenderTargetLayer> renderer = nullptr);
     std::shared_ptr<jt::RenderTargetLayer> get(int z) override;
+    bool needsRedraw(int z) const override;
+    void setLayerCached(int z, bool cached) override;
+    bool isLayerCached(int z) const override;
+    void setLayerIgnoresCamMovement(int z, bool ignore) override;
+    void invalidateLayer(int z, jt::Rectf const& rect) override;
+    void resetLayers() override;
+
+    /// Invalidate all cached layers that depend on the camera, because the camera moved
+    void invalidateCamLayers();
 
     void add(int z, std::shared_ptr<SDL_Texture> texture);
 
     void clearPixels();
 
+    /// Check if a layer can contain pixels in this frame
+    /// \param z the z layer
+    /// \return true if the layer needs to be composited, false otherwise
+    bool hasContent(int z) const;
+
     std::shared_ptr<SDL_Renderer> m_renderer { nullptr };
 
     std::map<int, std::shared_ptr<SDL_Texture>> m_textures;
+
+private:
+    jt::LayerStates m_layerStates;
 };
 } // namespace jt
 
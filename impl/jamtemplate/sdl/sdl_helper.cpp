@@ -1,4 +1,9 @@
 #include "sdl_helper.hpp"
+#include <asset_pack/virtual_file_system.hpp>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <stdexcept>
 
 namespace jt {
@@ -54,4 +59,66 @@ uint32_t getPixel(SDL_Surface* surface, int x, int y)
     }
 }
 
+std::uint32_t* getPixelRow(SDL_Surface* surface, int y)
+{
+    return reinterpret_cast<std::uint32_t*>(static_cast<std::uint8_t*>(surface->pixels)
+        + static_cast<std::ptrdiff_t>(y) * surface->pitch);
+}
+
+void copyPixelsRGBA32(SDL_Surface* surface, std::uint8_t const* rgba)
+{
+    auto const rowSize = static_cast<std::size_t>(surface->w) * 4u;
+    // rows of the surface can be padded, otherwise the whole image is copied at once
+    if (static_cast<std::size_t>(surface->pitch) == rowSize) {
+        std::memcpy(surface->pixels, rgba, rowSize * static_cast<std::size_t>(surface->h));
+        return;
+    }
+    for (int y = 0; y != surface->h; ++y) {
+        std::memcpy(getPixelRow(surface, y), rgba + static_cast<std::size_t>(y) * rowSize, rowSize);
+    }
+}
+
+SDL_RWops* openFile(std::string const& fileName)
+{
+    if (auto const data = jt::VirtualFileSystem::findInPack(fileName)) {
+        return SDL_RWFromConstMem(data->data(), static_cast<int>(data->size()));
+    }
+    return SDL_RWFromFile(fileName.c_str(), "rb");
+}
+
+std::string getImageType(std::string const& fileName)
+{
+    auto const pos = fileName.find_last_of('.');
+    if (pos == std::string::npos) {
+        return "";
+    }
+    auto type = fileName.substr(pos + 1);
+    std::transform(type.begin(), type.end(), type.begin(),
+        [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return type;
+}
+
+std::shared_ptr<SDL_Surface> loadImage(std::string const& fileName)
+{
+    // same as IMG_Load, which also uses the file extension as type hint
+    return std::shared_ptr<SDL_Surface>(
+        IMG_LoadTyped_RW(openFile(fileName), 1, getImageType(fileName).c_str()),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+}
+
+RenderStateScope::RenderStateScope(SDL_Renderer* renderer)
+    : m_renderer { renderer }
+{
+    m_target = SDL_GetRenderTarget(m_renderer);
+    SDL_GetRenderDrawBlendMode(m_renderer, &m_blendMode);
+    SDL_GetRenderDrawColor(m_renderer, &m_r, &m_g, &m_b, &m_a);
+}
+
+RenderStateScope::~RenderStateScope()
+{
+    SDL_SetRenderTarget(m_renderer, m_target);
+    SDL_SetRenderDrawBlendMode(m_renderer, m_blendMode);
+    SDL_SetRenderDrawColor(m_renderer, m_r, m_g, m_b, m_a);
+}
+
 } // namespace jt
@@ -4,6 +4,9 @@
 #include <vector.hpp>
 #include <sdl_2_include.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 namespace jt {
 
@@ -13,6 +16,55 @@ void setPixel(SDL_Surface* surface, int x, int y, uint32_t pixel);
 
 uint32_t getPixel(SDL_Surface* surface, int x, int y);
 
+/// Get the pixels of one row of a 32 bit surface, so a row can be written in one go instead of
+/// pixel by pixel
+/// \param surface the surface
+/// \param y the row
+/// \return pointer to the first pixel of the row
+std::uint32_t* getPixelRow(SDL_Surface* surface, int y);
+
+/// Copy rgba values into a surface with format SDL_PIXELFORMAT_RGBA32, one memcpy per row
+/// \param surface the surface
+/// \param rgba rgba values row by row, needs to hold 4 * w * h values
+void copyPixelsRGBA32(SDL_Surface* surface, std::uint8_t const* rgba);
+
+/// Open a file from the mounted asset packs, or from disk if it is not packed
+/// \param fileName path of the file
+/// \return the opened file, nullptr if it does not exist
+SDL_RWops* openFile(std::string const& fileName);
+
+/// Get the image type for SDL_image from the file extension, e.g. "PNG"
+/// \param fileName path of the file
+/// \return the image type
+std::string getImageType(std::string const& fileName);
+
+/// Load an image from the mounted asset packs, or from disk if it is not packed
+/// \param fileName path of the image
+/// \return the image, nullptr if it could not be loaded
+std::shared_ptr<SDL_Surface> loadImage(std::string const& fileName);
+
+/// Restores the render target, draw blend mode and draw color of a renderer when leaving a scope,
+/// so offscreen rendering does not leak state into later primitive draws
+class RenderStateScope {
+public:
+    /// Constructor
+    /// \param renderer the renderer, its current state is restored on destruction
+    explicit RenderStateScope(SDL_Renderer* renderer);
+    ~RenderStateScope();
+
+    RenderStateScope(RenderStateScope const&) = delete;
+    RenderStateScope& operator=(RenderStateScope const&) = delete;
+
+private:
+    SDL_Renderer* m_renderer { nullptr };
+    SDL_Texture* m_target { nullptr };
+    SDL_BlendMode m_blendMode { SDL_BLENDMODE_NONE };
+    std::uint8_t m_r { 0u };
+    std::uint8_t m_g { 0u };
+    std::uint8_t m_b { 0u };
+    std::uint8_t m_a { 0u };
+};
+
 } // namespace jt
 
 #endif // JAMTEMPLATE_SDLHELPER_HPP
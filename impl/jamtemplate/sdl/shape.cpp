@@ -3,6 +3,7 @@
 #include <sdl_2_include.hpp>
 #include <sdl_helper.hpp>
 #include <vector.hpp>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -12,6 +13,7 @@ void Shape::makeRect(jt::Vector2f size, jt::TextureManagerInterface& textureMana
     m_text = textureManager.get("#x#" + std::to_string(static_cast<int>(size.x)) + "#"
         + std::to_string(static_cast<int>(size.y)));
     m_sourceRect = jt::Recti { 0u, 0u, static_cast<int>(size.x), static_cast<int>(size.y) };
+    markTransformDirty();
 }
 
 void Shape::makeCircle(float radius, jt::TextureManagerInterface& textureManager)
@@ -19,13 +21,18 @@ void Shape::makeCircle(float radius, jt::TextureManagerInterface& textureManager
     m_text = textureManager.get("#c#" + std::to_string(static_cast<int>(radius)));
     m_sourceRect
         = jt::Recti { 0u, 0u, static_cast<int>(radius * 2.0f), static_cast<int>(radius * 2.0f) };
+    markTransformDirty();
 }
 
 void Shape::setColor(jt::Color const& col) { m_color = col; }
 
 jt::Color Shape::getColor() const { return m_color; }
 
-void Shape::setPosition(jt::Vector2f const& pos) { m_position = pos; }
+void Shape::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
 
 jt::Vector2f Shape::getPosition() const { return m_position; }
 
@@ -47,6 +54,7 @@ void Shape::setScale(jt::Vector2f const& scale)
 {
     m_scale = scale;
     setOriginInternal(m_origin);
+    markTransformDirty();
 }
 
 jt::Vector2f Shape::getScale() const { return m_scale; }
@@ -57,13 +65,9 @@ void Shape::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
         return;
     }
 
-    SDL_Rect const destRect = getDestRect();
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), getSDLBlendMode());
-    setSDLColor(m_color);
-    SDL_RenderCopyEx(sptr.get(), m_text.get(), nullptr, &destRect, getRotation(), &p, flip);
+    auto command = createRenderCommand(sptr, m_destRect, m_color);
+    command.blendMode = getSDLBlendMode();
+    submit(command);
 }
 
 void Shape::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -72,13 +76,8 @@ void Shape::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
         return;
     }
 
-    SDL_Rect const destRect = getDestRect();
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    setSDLColor(getFlashColor());
-    SDL_RenderCopyEx(sptr.get(), m_text.get(), nullptr, &destRect, getRotation(), &p, flip);
+    // flash is drawn immediately, so it always ends up above the shape, even in sorted ZLayers
+    submit(createRenderCommand(sptr, m_destRect, getFlashColor()), false);
 }
 
 void Shape::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -87,13 +86,7 @@ void Shape::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) cons
         return;
     }
 
-    SDL_Rect const destRect = getDestRect(getShadowOffset());
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    setSDLColor(getShadowColor());
-    SDL_RenderCopyEx(sptr.get(), m_text.get(), nullptr, &destRect, getRotation(), &p, flip);
+    submit(createRenderCommand(sptr, getDestRect(getShadowOffset()), getShadowColor()));
 }
 
 void Shape::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -102,15 +95,54 @@ void Shape::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) con
         return;
     }
 
-    setSDLColor(getOutlineColor());
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-
+    auto command = createRenderCommand(sptr, m_destRect, getOutlineColor());
     for (auto const& outlineOffset : getOutlineOffsets()) {
-        SDL_Rect const destRect = getDestRect(outlineOffset);
-        SDL_RenderCopyEx(sptr.get(), m_text.get(), nullptr, &destRect, getRotation(), &p, flip);
+        command.destRect = getDestRect(outlineOffset);
+        submit(command);
+    }
+}
+
+void Shape::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    auto command = createRenderCommand(sptr, m_destRect, m_color);
+    command.blendMode = getSDLBlendMode();
+    for (auto const& position : positions) {
+        command.destRect = getDestRect(position - m_position);
+        submit(command);
+    }
+}
+
+void Shape::doDrawTransformedInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::DrawInstance const> instances) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    auto command = createRenderCommand(sptr, m_destRect, m_color);
+    command.blendMode = getSDLBlendMode();
+    auto const offset = getShakeOffset() + getOffset() + getCompleteCamOffset();
+    auto const origin = getOrigin();
+    auto const width = static_cast<float>(m_sourceRect.width);
+    auto const height = static_cast<float>(m_sourceRect.height);
+    for (auto const& instance : instances) {
+        auto const scaledOrigin
+            = jt::Vector2f { origin.x * instance.scale.x, origin.y * instance.scale.y };
+        auto const pos = instance.position + offset - scaledOrigin;
+        command.destRect = SDL_Rect { static_cast<int>(pos.x), static_cast<int>(pos.y),
+            static_cast<int>(width * fabs(instance.scale.x)),
+            static_cast<int>(height * fabs(instance.scale.y)) };
+        command.center
+            = SDL_Point { static_cast<int>(scaledOrigin.x), static_cast<int>(scaledOrigin.y) };
+        command.flip = jt::getFlipFromScale(instance.scale);
+        command.angle = instance.rotation;
+        command.color = instance.color;
+        submit(command);
     }
 }
 
@@ -128,10 +160,30 @@ SDL_Rect Shape::getDestRect(jt::Vector2f const& positionOffset) const
     return destRect;
 }
 
-void Shape::setSDLColor(jt::Color const& col) const
+jt::RenderCommand Shape::createRenderCommand(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+    SDL_Rect const& destRect, jt::Color const& col) const
 {
-    SDL_SetTextureColorMod(m_text.get(), col.r, col.g, col.b);
-    SDL_SetTextureAlphaMod(m_text.get(), col.a);
+    jt::RenderCommand command;
+    command.renderer = sptr.get();
+    command.target = SDL_GetRenderTarget(sptr.get());
+    command.texture = m_text;
+    command.destRect = destRect;
+    command.angle = getRotation();
+    command.center = m_center;
+    command.flip = m_flip;
+    command.color = col;
+    command.blendMode = SDL_BLENDMODE_BLEND;
+    return command;
+}
+
+bool Shape::usesRenderQueue() const { return true; }
+
+void Shape::doRefreshTransform() const
+{
+    m_destRect = getDestRect();
+    m_center = SDL_Point { static_cast<int>(getOrigin().x * m_scale.x),
+        static_cast<int>(getOrigin().y * m_scale.y) };
+    m_flip = jt::getFlipFromScale(m_scale);
 }
 
 } // namespace jt
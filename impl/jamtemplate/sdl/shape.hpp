@@ -3,6 +3,7 @@
 
 #include <drawable_impl_sdl.hpp>
 #include <rect.hpp>
+#include <render_command_lib.hpp>
 #include <render_target_layer.hpp>
 #include <sdl_2_include.hpp>
 #include <texture_manager_interface.hpp>
@@ -36,17 +37,30 @@ private:
     jt::Recti m_sourceRect { 0, 0, 0, 0 };
     jt::Color m_color { jt::colors::White };
 
+    // backend transform, calculated in doRefreshTransform()
+    mutable SDL_Rect m_destRect { 0, 0, 0, 0 };
+    mutable SDL_Point m_center { 0, 0 };
+    mutable SDL_RendererFlip m_flip { SDL_FLIP_NONE };
+
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const override;
+    void doDrawTransformedInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::DrawInstance const> instances) const override;
 
     void doUpdate(float /*elapsed*/) noexcept override;
     void doRotate(float /*rot*/) noexcept override;
 
     SDL_Rect getDestRect(jt::Vector2f const& positionOffset = jt::Vector2f { 0, 0 }) const;
 
-    void setSDLColor(jt::Color const& col) const;
+    jt::RenderCommand createRenderCommand(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+        SDL_Rect const& destRect, jt::Color const& col) const;
+
+    bool usesRenderQueue() const override;
+    void doRefreshTransform() const override;
 };
 } // namespace jt
 
@@ -1,7 +1,6 @@
 ﻿#include "sprite.hpp"
 #include <math_helper.hpp>
 #include <sdl_helper.hpp>
-#include <SDL_image.h>
 #include <iostream>
 #include <stdexcept>
 
@@ -19,7 +18,7 @@ Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& texture
         m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
     m_sourceRect = jt::Recti { 0, 0, w, h };
 
-    m_textFlash = textureManager.get(textureManager.getFlashName(fileName));
+    m_textureManager = &textureManager;
 }
 
 Sprite::Sprite(
@@ -33,7 +32,29 @@ Sprite::Sprite(
         m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
     m_sourceRect = jt::Recti { rect };
 
-    m_textFlash = textureManager.get(textureManager.getFlashName(fileName));
+    m_textureManager = &textureManager;
+}
+
+Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager,
+    jt::LoadAsyncTag)
+{
+    m_text = textureManager.getAsync(fileName);
+    m_fileName = fileName;
+    m_textureManager = &textureManager;
+    m_textureLoading = true;
+    takeLoadedTexture();
+}
+
+Sprite::Sprite(std::string const& fileName, jt::Recti const& rect,
+    jt::TextureManagerInterface& textureManager, jt::LoadAsyncTag)
+{
+    m_text = textureManager.getAsync(fileName);
+    m_fileName = fileName;
+    m_sourceRect = jt::Recti { rect };
+    m_useWholeTexture = false;
+    m_textureManager = &textureManager;
+    m_textureLoading = true;
+    takeLoadedTexture();
 }
 
 void Sprite::fromTexture(std::shared_ptr<SDL_Texture> const& txt)
@@ -41,14 +62,22 @@ void Sprite::fromTexture(std::shared_ptr<SDL_Texture> const& txt)
     m_text = txt;
     m_textFlash = txt;
     m_fileName = "";
+    m_textureLoading = false;
+    m_textureManager = nullptr;
+    m_textOutline = nullptr;
     int w { 0 };
     int h { 0 };
     SDL_QueryTexture(
         m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
     m_sourceRect = jt::Recti { 0, 0, w, h };
+    markTransformDirty();
 }
 
-void Sprite::setPosition(jt::Vector2f const& pos) { m_position = pos; }
+void Sprite::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
 
 jt::Vector2f Sprite::getPosition() const { return m_position; }
 
@@ -72,6 +101,7 @@ void Sprite::setScale(jt::Vector2f const& scale)
 {
     m_scale = scale;
     setOriginInternal(m_origin);
+    markTransformDirty();
 }
 
 jt::Vector2f Sprite::getScale() const { return m_scale; }
@@ -79,8 +109,7 @@ jt::Vector2f Sprite::getScale() const { return m_scale; }
 jt::Color Sprite::getColorAtPixel(jt::Vector2u pixelPos) const
 {
     if (!m_image) {
-        m_image = std::shared_ptr<SDL_Surface>(
-            IMG_Load(m_fileName.c_str()), [](SDL_Surface* s) { SDL_FreeSurface(s); });
+        m_image = jt::loadImage(m_fileName);
         if (!m_image) {
             std::cout << "Warning: file could not be loaded for getpixels\n";
             return jt::colors::Black;
@@ -102,7 +131,39 @@ jt::Color Sprite::getColorAtPixel(jt::Vector2u pixelPos) const
 
 void Sprite::cleanImage() noexcept { m_image = nullptr; }
 
-void Sprite::doUpdate(float /*elapsed*/) { }
+void Sprite::setTextureRect(jt::Recti const& rect)
+{
+    m_useWholeTexture = false;
+    if (m_sourceRect == rect) [[likely]] {
+        return;
+    }
+    m_sourceRect = rect;
+    // silhouettes are created per area of the texture
+    m_textOutline = nullptr;
+    markTransformDirty();
+    markContentChanged();
+}
+
+jt::Recti Sprite::getTextureRect() const { return m_sourceRect; }
+
+void Sprite::doUpdate(float /*elapsed*/) { takeLoadedTexture(); }
+
+void Sprite::takeLoadedTexture()
+{
+    if (!m_textureLoading || !m_textureManager->isLoaded(m_fileName)) [[likely]] {
+        return;
+    }
+    m_textureLoading = false;
+    m_text = m_textureManager->get(m_fileName);
+    if (m_useWholeTexture) {
+        int w { 0 };
+        int h { 0 };
+        SDL_QueryTexture(m_text.get(), nullptr, nullptr, &w, &h);
+        m_sourceRect = jt::Recti { 0, 0, w, h };
+    }
+    markTransformDirty();
+    markContentChanged();
+}
 
 void Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
@@ -110,14 +171,7 @@ void Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
         return;
     }
 
-    SDL_Rect const sourceRect = getSourceRect();
-    SDL_Rect const destRect = getDestRect();
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    setSDLColor(m_color);
-    SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
+    submit(createRenderCommand(sptr, m_text, m_destRect, m_color));
 }
 
 void Sprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -126,52 +180,78 @@ void Sprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) con
         return;
     }
 
-    SDL_Rect const sourceRect = getSourceRect();
-    SDL_Rect const destRect = getDestRect(getShadowOffset());
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    setSDLColor(getShadowColor());
-    SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
+    submit(createRenderCommand(sptr, m_text, getDestRect(getShadowOffset()), getShadowColor()));
 }
 
 void Sprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
+    // the silhouette would be created from the texture, which is not available yet
+    if (!sptr || m_textureLoading) [[unlikely]] {
         return;
     }
 
-    SDL_Rect const sourceRect = getSourceRect();
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    setSDLColor(getOutlineColor());
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    for (auto const& outlineOffset : getOutlineOffsets()) {
-        SDL_Rect const destRect = getDestRect(outlineOffset);
+    auto const width = getOutlineWidth();
+    if (m_textureManager && width > 0) [[likely]] {
+        if (!m_textOutline || m_textOutlineWidth != width) {
+            m_textOutline = m_textureManager->getOutline(m_fileName, m_sourceRect, width);
+            m_textOutlineWidth = width;
+        }
+    } else {
+        m_textOutline = nullptr;
+    }
 
-        SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
+    if (!m_textOutline) [[unlikely]] {
+        // no texture manager available (e.g. for sprites created from a texture): stamp the
+        // sprite at all outline offsets
+        auto command = createRenderCommand(sptr, m_text, m_destRect, getOutlineColor());
+        for (auto const& outlineOffset : getOutlineOffsets()) {
+            command.destRect = getDestRect(outlineOffset);
+            submit(command);
+        }
+        return;
     }
+
+    // the silhouette is larger than the sprite by the outline width in every direction
+    auto const scale = jt::Vector2f { std::fabs(m_scale.x), std::fabs(m_scale.y) };
+    auto const border = jt::Vector2f { static_cast<float>(width) * scale.x,
+        static_cast<float>(width) * scale.y };
+    auto command = createRenderCommand(sptr, m_textOutline, m_destRect, getOutlineColor());
+    command.sourceRect
+        = SDL_Rect { 0, 0, m_sourceRect.width + 2 * width, m_sourceRect.height + 2 * width };
+    command.destRect.x -= static_cast<int>(border.x);
+    command.destRect.y -= static_cast<int>(border.y);
+    command.destRect.w += 2 * static_cast<int>(border.x);
+    command.destRect.h += 2 * static_cast<int>(border.y);
+    command.center.x += static_cast<int>(border.x);
+    command.center.y += static_cast<int>(border.y);
+    submit(command);
 }
 
 void Sprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!sptr || m_textureLoading) [[unlikely]] {
+        return;
+    }
+
+    if (!m_textFlash && m_textureManager) {
+        m_textFlash = m_textureManager->get(m_textureManager->getFlashName(m_fileName));
+    }
+    // flash is drawn immediately, so it always ends up above the sprite, even in sorted ZLayers
+    submit(createRenderCommand(sptr, m_textFlash, m_destRect, getFlashColor()), false);
+}
+
+void Sprite::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
 {
     if (!sptr) [[unlikely]] {
         return;
     }
 
-    SDL_Rect const sourceRect = getSourceRect();
-    SDL_Rect const destRect = getDestRect();
-    auto const flip = jt::getFlipFromScale(m_scale);
-    SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
-        static_cast<int>(getOrigin().y * m_scale.y) };
-    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
-    SDL_SetTextureColorMod(
-        m_textFlash.get(), getFlashColor().r, getFlashColor().g, getFlashColor().b);
-    SDL_SetTextureAlphaMod(m_textFlash.get(), getFlashColor().a);
-    SDL_RenderCopyEx(
-        sptr.get(), m_textFlash.get(), &sourceRect, &destRect, getRotation(), &p, flip);
+    auto command = createRenderCommand(sptr, m_text, m_destRect, m_color);
+    for (auto const& position : positions) {
+        command.destRect = getDestRect(position - m_position);
+        submit(command);
+    }
 }
 
 void Sprite::doRotate(float /*rot*/) noexcept { }
@@ -194,10 +274,32 @@ SDL_Rect Sprite::getSourceRect() const
         m_sourceRect.height };
 }
 
-void Sprite::setSDLColor(jt::Color const& col) const
+jt::RenderCommand Sprite::createRenderCommand(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+    std::shared_ptr<SDL_Texture> const& texture, SDL_Rect const& destRect,
+    jt::Color const& col) const
 {
-    SDL_SetTextureColorMod(m_text.get(), col.r, col.g, col.b);
-    SDL_SetTextureAlphaMod(m_text.get(), col.a);
+    jt::RenderCommand command;
+    command.renderer = sptr.get();
+    command.target = SDL_GetRenderTarget(sptr.get());
+    command.texture = texture;
+    command.sourceRect = getSourceRect();
+    command.destRect = destRect;
+    command.angle = getRotation();
+    command.center = m_center;
+    command.flip = m_flip;
+    command.color = col;
+    command.blendMode = SDL_BLENDMODE_BLEND;
+    return command;
+}
+
+bool Sprite::usesRenderQueue() const { return true; }
+
+void Sprite::doRefreshTransform() const
+{
+    m_destRect = getDestRect();
+    m_center = SDL_Point { static_cast<int>(getOrigin().x * m_scale.x),
+        static_cast<int>(getOrigin().y * m_scale.y) };
+    m_flip = jt::getFlipFromScale(m_scale);
 }
 
 } // namespace jt
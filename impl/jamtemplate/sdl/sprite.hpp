@@ -3,6 +3,8 @@
 
 #include <color/color.hpp>
 #include <drawable_impl_sdl.hpp>
+#include <graphics/load_async.hpp>
+#include <render_command_lib.hpp>
 #include <render_target_layer.hpp>
 #include <sdl_2_include.hpp>
 #include <texture_manager_interface.hpp>
@@ -22,6 +24,21 @@ public:
     Sprite(std::string const& fileName, jt::Recti const& rect,
         jt::TextureManagerInterface& textureManager);
 
+    /// Constructor that does not wait for the texture to be decoded. A transparent placeholder is
+    /// drawn until the texture is uploaded, the sprite picks it up in update(). Until then the
+    /// bounds of the sprite are empty.
+    /// \param fileName texture identifier
+    /// \param textureManager texture manager
+    Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager,
+        jt::LoadAsyncTag);
+
+    /// Constructor that does not wait for the texture to be decoded, see above
+    /// \param fileName texture identifier
+    /// \param rect area of the texture to draw
+    /// \param textureManager texture manager
+    Sprite(std::string const& fileName, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager, jt::LoadAsyncTag);
+
     // DO NOT CALL THIS FROM GAME CODE!
     void fromTexture(std::shared_ptr<SDL_Texture> const& txt);
 
@@ -31,6 +48,14 @@ public:
 
     void cleanImage() noexcept;
 
+    /// Set the area of the texture to draw, e.g. the current frame of an animation
+    /// \param rect area of the texture in pixel
+    void setTextureRect(jt::Recti const& rect);
+
+    /// Get the area of the texture to draw
+    /// \return area of the texture in pixel
+    jt::Recti getTextureRect() const;
+
 
     void setPosition(jt::Vector2f const& pos) override;
     jt::Vector2f getPosition() const override;
@@ -51,22 +76,44 @@ private:
     jt::Recti m_sourceRect { 0, 0, 0, 0 };
     jt::Color m_color { jt::colors::White };
 
-    mutable std::shared_ptr<SDL_Texture> m_textFlash;
+    // backend transform, calculated in doRefreshTransform()
+    mutable SDL_Rect m_destRect { 0, 0, 0, 0 };
+    mutable SDL_Point m_center { 0, 0 };
+    mutable SDL_RendererFlip m_flip { SDL_FLIP_NONE };
+
     std::string m_fileName { "" };
+    // placeholder is drawn until the texture manager uploaded the texture
+    bool m_textureLoading { false };
+    bool m_useWholeTexture { true };
+
+    // flash texture and outline silhouette are requested from the texture manager when they are
+    // drawn first
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    mutable std::shared_ptr<SDL_Texture> m_textFlash;
+    mutable std::shared_ptr<SDL_Texture> m_textOutline { nullptr };
+    mutable int m_textOutlineWidth { 0 };
 
     mutable std::shared_ptr<SDL_Surface> m_image { nullptr };
 
     void doUpdate(float /*elapsed*/) override;
+    void takeLoadedTexture();
 
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const override;
     void doRotate(float /*rot*/) noexcept override;
 
     SDL_Rect getDestRect(jt::Vector2f const& positionOffset = jt::Vector2f { 0.0f, 0.0f }) const;
     SDL_Rect getSourceRect() const;
-    void setSDLColor(jt::Color const& col) const;
+    jt::RenderCommand createRenderCommand(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+        std::shared_ptr<SDL_Texture> const& texture, SDL_Rect const& destRect,
+        jt::Color const& col) const;
+
+    bool usesRenderQueue() const override;
+    void doRefreshTransform() const override;
 };
 
 } // namespace jt
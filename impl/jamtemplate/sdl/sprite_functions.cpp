@@ -5,6 +5,7 @@
 #include <cmath>
 #include <numbers>
 #include <algorithm>
+#include <cstdint>
 
 namespace jt {
 
@@ -25,25 +26,22 @@ std::shared_ptr<SDL_Texture> makeButtonImage(std::shared_ptr<jt::RenderTargetLay
     auto const bright
         = SDL_MapRGBA(image->format, brightColor.r, brightColor.g, brightColor.b, max);
 
-    for (auto i = 0u; i != w * 3; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            jt::setPixel(image.get(), i, j, mid);
-        }
-    }
+    SDL_FillRect(image.get(), nullptr, mid);
 
-    for (int i = 0; i != wAsInt; ++i) {
-        setPixel(image.get(), i, 0, bright);
-        setPixel(image.get(), i, hAsInt - 1, dark);
-        setPixel(image.get(), 2 * wAsInt + i, 0, dark);
-        setPixel(image.get(), 2 * wAsInt + i, hAsInt - 1, bright);
-    }
+    // borders are filled as one pixel wide rects, columns overwrite the corners of the rows
+    auto fill = [&image](int x, int y, int rectW, int rectH, std::uint32_t col) {
+        SDL_Rect const rect { x, y, rectW, rectH };
+        SDL_FillRect(image.get(), &rect, col);
+    };
+    fill(0, 0, wAsInt, 1, bright);
+    fill(0, hAsInt - 1, wAsInt, 1, dark);
+    fill(2 * wAsInt, 0, wAsInt, 1, dark);
+    fill(2 * wAsInt, hAsInt - 1, wAsInt, 1, bright);
 
-    for (int j = 0; j != hAsInt; ++j) {
-        setPixel(image.get(), 0, j, bright);
-        setPixel(image.get(), wAsInt - 1, j, dark);
-        setPixel(image.get(), 2 * wAsInt, j, dark);
-        setPixel(image.get(), 3 * wAsInt - 1, j, bright);
-    }
+    fill(0, 0, 1, hAsInt, bright);
+    fill(wAsInt - 1, 0, 1, hAsInt, dark);
+    fill(2 * wAsInt, 0, 1, hAsInt, dark);
+    fill(3 * wAsInt - 1, 0, 1, hAsInt, bright);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     return std::shared_ptr<SDL_Texture>(
         SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
@@ -57,13 +55,8 @@ std::shared_ptr<SDL_Texture> makeBlankImage(
         SDL_CreateRGBSurface(0, static_cast<int>(w), static_cast<int>(h), 32, 0, 0, 0, 0),
         [](SDL_Surface* s) { SDL_FreeSurface(s); });
 
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            auto const max = std::numeric_limits<std::uint8_t>::max();
-            auto const col = SDL_MapRGBA(image->format, max, max, max, max);
-            jt::setPixel(image.get(), i, j, col);
-        }
-    }
+    auto const max = std::numeric_limits<std::uint8_t>::max();
+    SDL_FillRect(image.get(), nullptr, SDL_MapRGBA(image->format, max, max, max, max));
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     return std::shared_ptr<SDL_Texture>(
@@ -81,18 +74,21 @@ std::shared_ptr<SDL_Texture> makeGlowImage(
 
     float const c = r / 2;
 
-    for (auto i = 0u; i != s; ++i) {
-        for (auto j = 0u; j != s; ++j) {
+    // only the alpha changes per pixel, so the color is mapped once and the alpha is shifted in
+    constexpr auto maxUint8 = std::numeric_limits<std::uint8_t>::max();
+    auto const white = SDL_MapRGBA(image->format, maxUint8, maxUint8, maxUint8, 0u);
+    auto const alphaShift = image->format->Ashift;
+    for (auto j = 0u; j != s; ++j) {
+        auto* const row = jt::getPixelRow(image.get(), static_cast<int>(j));
+        auto const dy = j - c;
+        for (auto i = 0u; i != s; ++i) {
             auto const dx = i - c;
-            auto const dy = j - c;
 
             auto const sqr = jt::MathHelper::qsqrt(dx * dx + dy * dy);
             auto const sqrNorm = 1.0f - std::clamp(sqr / s * 2.0f, 0.0f, 1.0f);
-            float const v = std::pow(sqrNorm, 2.0f) * static_cast<float>(max);
+            float const v = sqrNorm * sqrNorm * static_cast<float>(max);
 
-            constexpr auto maxUint8 = std::numeric_limits<std::uint8_t>::max();
-            jt::setPixel(image.get(), i, j,
-                SDL_MapRGBA(image->format, maxUint8, maxUint8, maxUint8, static_cast<uint8_t>(v)));
+            row[i] = white | (static_cast<std::uint32_t>(static_cast<uint8_t>(v)) << alphaShift);
         }
     }
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
@@ -112,15 +108,18 @@ std::shared_ptr<SDL_Texture> makeVignetteImage(
     SDL_SetSurfaceBlendMode(image.get(), SDL_BLENDMODE_BLEND);
     float const cx = static_cast<float>(w) / 2.0f;
     float const cy = static_cast<float>(h) / 2.0f;
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
+    auto const black = SDL_MapRGBA(image->format, 0u, 0u, 0u, 0u);
+    auto const alphaShift = image->format->Ashift;
+    for (auto j = 0u; j != h; ++j) {
+        auto* const row = jt::getPixelRow(image.get(), static_cast<int>(j));
+        auto const dy = j - cy;
+        for (auto i = 0u; i != w; ++i) {
             auto const dx = i - cx;
-            auto const dy = j - cy;
             auto const sqr = jt::MathHelper::qsqrt(dx * dx + dy * dy);
             auto const sqrNorm = std::clamp(sqr / (cx + cy) / 1.5f * 2.0f, 0.0f, 1.0f);
             auto const v
                 = static_cast<uint8_t>(std::pow(sqrNorm, 3.5f) * 245 + jt::Random::getInt(0, 10));
-            jt::setPixel(image.get(), i, j, SDL_MapRGBA(image->format, 0u, 0u, 0u, v));
+            row[i] = black | (static_cast<std::uint32_t>(v) << alphaShift);
         }
     }
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
@@ -159,18 +158,17 @@ std::shared_ptr<SDL_Texture> makeCircle(
 
     float const c = r;
 
-    for (auto i = 0u; i != s; ++i) {
-        for (auto j = 0u; j != s; ++j) {
+    auto const max = std::numeric_limits<std::uint8_t>::max();
+    auto const inside = SDL_MapRGBA(image->format, max, max, max, max);
+    auto const outside = SDL_MapRGBA(image->format, max, max, max, 0u);
+    for (auto j = 0u; j != s; ++j) {
+        auto* const row = jt::getPixelRow(image.get(), static_cast<int>(j));
+        auto const dy = j - c;
+        for (auto i = 0u; i != s; ++i) {
             auto const dx = i - c;
-            auto const dy = j - c;
 
             auto const sqr = jt::MathHelper::qsqrt(dx * dx + dy * dy);
-
-            float const v = (sqr < r) ? 255 : 0;
-
-            auto const max = std::numeric_limits<std::uint8_t>::max();
-            jt::setPixel(image.get(), i, j,
-                SDL_MapRGBA(image->format, max, max, max, static_cast<uint8_t>(v)));
+            row[i] = (sqr < r) ? inside : outside;
         }
     }
 
@@ -211,5 +209,182 @@ std::shared_ptr<SDL_Texture> makeRing(
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
+std::shared_ptr<SDL_Texture> makeStripImage(std::shared_ptr<jt::RenderTargetLayer> renderTarget,
+    SDL_Surface* start, SDL_Surface* middle, SDL_Surface* end, unsigned int w, unsigned int h,
+    bool horizontal)
+{
+    auto const wAsInt = static_cast<int>(w);
+    auto const hAsInt = static_cast<int>(h);
+    std::shared_ptr<SDL_Surface> image = std::shared_ptr<SDL_Surface>(
+        SDL_CreateRGBSurfaceWithFormat(0, wAsInt, hAsInt, 32, SDL_PIXELFORMAT_RGBA32),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    SDL_FillRect(image.get(), nullptr, SDL_MapRGBA(image->format, 0, 0, 0, 0));
+
+    // pieces are copied including their alpha values instead of being blended onto the image
+    for (auto* piece : { start, middle, end }) {
+        SDL_SetSurfaceBlendMode(piece, SDL_BLENDMODE_NONE);
+    }
+    auto blit = [&image](SDL_Surface* piece, int x, int y) {
+        SDL_Rect destRect { x, y, piece->w, piece->h };
+        SDL_BlitSurface(piece, nullptr, image.get(), &destRect);
+    };
+
+    if (horizontal) {
+        auto const rowHeight = std::max(1, start->h);
+        for (auto y = 0; y < hAsInt; y += rowHeight) {
+            for (auto x = start->w; x < wAsInt - end->w; x += std::max(1, middle->w)) {
+                blit(middle, x, y);
+            }
+            blit(start, 0, y);
+            blit(end, wAsInt - end->w, y);
+        }
+    } else {
+        auto const columnWidth = std::max(1, start->w);
+        for (auto x = 0; x < wAsInt; x += columnWidth) {
+            for (auto y = start->h; y < hAsInt - end->h; y += std::max(1, middle->h)) {
+                blit(middle, x, y);
+            }
+            blit(start, x, 0);
+            blit(end, x, hAsInt - end->h);
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    return std::shared_ptr<SDL_Texture>(
+        SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+}
+
+namespace {
+
+std::shared_ptr<SDL_Texture> createOutlineTarget(SDL_Renderer* renderer, int w, int h)
+{
+    auto outline = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    if (outline) {
+        SDL_SetTextureBlendMode(outline.get(), SDL_BLENDMODE_BLEND);
+    }
+    return outline;
+}
+
+// texture needs to use the silhouette blend mode
+std::shared_ptr<SDL_Texture> stampOutline(
+    SDL_Renderer* renderer, SDL_Texture* texture, SDL_Rect const& sourceRect, int width)
+{
+    auto outline
+        = createOutlineTarget(renderer, sourceRect.w + 2 * width, sourceRect.h + 2 * width);
+    if (!outline) {
+        return nullptr;
+    }
+    SDL_SetRenderTarget(renderer, outline.get());
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 255u, 255u, 255u, 0u);
+    SDL_RenderClear(renderer);
+    for (auto x = 0; x <= 2 * width; ++x) {
+        for (auto y = 0; y <= 2 * width; ++y) {
+            SDL_Rect const destRect { x, y, sourceRect.w, sourceRect.h };
+            SDL_RenderCopy(renderer, texture, &sourceRect, &destRect);
+        }
+    }
+    return outline;
+}
+
+// fallback for renderers without custom blend modes: read back the source area once and build the
+// silhouette on the cpu, overlapping alpha values are combined by their maximum
+std::shared_ptr<SDL_Texture> stampOutlineOnCpu(
+    SDL_Renderer* renderer, SDL_Texture* texture, SDL_Rect const& sourceRect, int width)
+{
+    auto const copy = createOutlineTarget(renderer, sourceRect.w, sourceRect.h);
+    auto const source = std::shared_ptr<SDL_Surface>(
+        SDL_CreateRGBSurfaceWithFormat(0, sourceRect.w, sourceRect.h, 32, SDL_PIXELFORMAT_RGBA32),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    auto const w = sourceRect.w + 2 * width;
+    auto const h = sourceRect.h + 2 * width;
+    auto const image = std::shared_ptr<SDL_Surface>(
+        SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    if (!copy || !source || !image) {
+        return nullptr;
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+    SDL_SetRenderTarget(renderer, copy.get());
+    SDL_RenderCopy(renderer, texture, &sourceRect, nullptr);
+    if (SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, source->pixels,
+            source->pitch)
+        != 0) {
+        return nullptr;
+    }
+
+    SDL_FillRect(image.get(), nullptr, SDL_MapRGBA(image->format, 255u, 255u, 255u, 0u));
+    for (auto y = 0; y < sourceRect.h; ++y) {
+        auto const* const sourceRow
+            = static_cast<std::uint8_t const*>(source->pixels) + y * source->pitch;
+        for (auto x = 0; x < sourceRect.w; ++x) {
+            auto const alpha = sourceRow[4 * x + 3];
+            if (alpha == 0u) {
+                continue;
+            }
+            for (auto dy = 0; dy <= 2 * width; ++dy) {
+                auto* const row
+                    = static_cast<std::uint8_t*>(image->pixels) + (y + dy) * image->pitch;
+                for (auto dx = 0; dx <= 2 * width; ++dx) {
+                    auto& target = row[4 * (x + dx) + 3];
+                    target = std::max(target, alpha);
+                }
+            }
+        }
+    }
+
+    auto outline = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTextureFromSurface(renderer, image.get()),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    if (outline) {
+        SDL_SetTextureBlendMode(outline.get(), SDL_BLENDMODE_BLEND);
+    }
+    return outline;
+}
+
+} // namespace
+
+std::shared_ptr<SDL_Texture> makeOutlineImage(std::shared_ptr<jt::RenderTargetLayer> renderTarget,
+    SDL_Texture* texture, SDL_Rect const& sourceRect, int width)
+{
+    auto* const renderer = renderTarget.get();
+    if (!renderer || !texture) {
+        return nullptr;
+    }
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    jt::RenderStateScope const renderState { renderer };
+
+    // the source texture is shared with sprites, which leave their color and alpha modulation on
+    // it. Stamp with full modulation, so a faded out sprite still creates the full silhouette.
+    SDL_BlendMode previousBlendMode { SDL_BLENDMODE_BLEND };
+    std::uint8_t previousAlpha { 255u };
+    std::uint8_t previousR { 255u };
+    std::uint8_t previousG { 255u };
+    std::uint8_t previousB { 255u };
+    SDL_GetTextureBlendMode(texture, &previousBlendMode);
+    SDL_GetTextureAlphaMod(texture, &previousAlpha);
+    SDL_GetTextureColorMod(texture, &previousR, &previousG, &previousB);
+    SDL_SetTextureAlphaMod(texture, 255u);
+    SDL_SetTextureColorMod(texture, 255u, 255u, 255u);
+
+    // keep the white color of the target and only accumulate the alpha of the source, so the
+    // texture is stamped as a silhouette regardless of its colors
+    auto const silhouetteBlendMode = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ZERO,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+        SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    auto const outline = SDL_SetTextureBlendMode(texture, silhouetteBlendMode) == 0
+        ? stampOutline(renderer, texture, sourceRect, width)
+        : stampOutlineOnCpu(renderer, texture, sourceRect, width);
+
+    SDL_SetTextureBlendMode(texture, previousBlendMode);
+    SDL_SetTextureAlphaMod(texture, previousAlpha);
+    SDL_SetTextureColorMod(texture, previousR, previousG, previousB);
+    return outline;
+}
+
 } // namespace SpriteFunctions
 } // namespace jt
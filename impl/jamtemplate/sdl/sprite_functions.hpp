@@ -32,6 +32,31 @@ std::shared_ptr<SDL_Texture> makeCircle(
 std::shared_ptr<SDL_Texture> makeRing(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w);
 
+/// Compose a strip from a start, a repeated middle and an end piece.
+/// \param renderTarget the render target
+/// \param start piece at the left (horizontal) or top (vertical)
+/// \param middle piece repeated between start and end
+/// \param end piece at the right (horizontal) or bottom (vertical)
+/// \param w width of the strip
+/// \param h height of the strip
+/// \param horizontal if true, pieces are placed left to right and rows are repeated vertically,
+/// if false, pieces are placed top to bottom and columns are repeated horizontally
+/// \return the composed texture
+std::shared_ptr<SDL_Texture> makeStripImage(std::shared_ptr<jt::RenderTargetLayer> renderTarget,
+    SDL_Surface* start, SDL_Surface* middle, SDL_Surface* end, unsigned int w, unsigned int h,
+    bool horizontal);
+
+/// Create the outline silhouette of an area of a texture: every pixel that is at most width pixel
+/// (horizontally and vertically) away from a non-transparent pixel is opaque white.
+/// \param renderTarget the render target
+/// \param texture the source texture
+/// \param sourceRect area of the source texture
+/// \param width outline width in pixel, the silhouette is larger than sourceRect by width pixel
+/// in every direction
+/// \return the silhouette texture, to be tinted with the outline color via color modulation
+std::shared_ptr<SDL_Texture> makeOutlineImage(std::shared_ptr<jt::RenderTargetLayer> renderTarget,
+    SDL_Texture* texture, SDL_Rect const& sourceRect, int width);
+
 } // namespace SpriteFunctions
 
 } // namespace jt
@@ -1,34 +1,30 @@
 ﻿#include "text.hpp"
+#include <math_helper.hpp>
 #include <sdl_helper.hpp>
 #include <strutils.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
 namespace jt {
 
-Text::~Text()
-{
-    if (m_font != nullptr) {
-        TTF_CloseFont(m_font);
-    }
-}
-
 void Text::loadFont(std::string const& fontFileName, unsigned int characterSize,
-    std::weak_ptr<jt::RenderTargetLayer> wptr)
+    std::weak_ptr<jt::RenderTargetLayer> wptr, jt::FontCacheInterface& fontCache)
 {
-    m_font = TTF_OpenFont(fontFileName.c_str(), static_cast<int>(characterSize));
-
-    if (!m_font) {
-        std::cerr << "cannot load font: " << fontFileName << std::endl
-                  << "error message: " << TTF_GetError() << std::endl;
-    }
-    m_rendertarget = wptr;
+    m_atlas = fontCache.get(fontFileName, characterSize, wptr.lock());
+    updateGlyphLayout();
 }
 
 void Text::setText(std::string const& text)
 {
+    if (m_text == text) {
+        return;
+    }
     m_text = text;
-    recreateTextTexture(getRenderTarget());
+    updateGlyphLayout();
+    markContentChanged();
 }
 
 std::string Text::getText() const { return m_text; }
@@ -66,7 +62,8 @@ void Text::setTextAlign(Text::TextAlign ta)
 {
     if (m_textAlign != ta) {
         m_textAlign = ta;
-        recreateTextTexture(getRenderTarget());
+        updateGlyphLayout();
+        markContentChanged();
     }
 }
 
@@ -79,63 +76,47 @@ void Text::doUpdate(float /*elapsed*/)
 
 void Text::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
-        return;
-    }
-    auto const destRect = getDestRect(getShadowOffset());
-    SDL_Point const p { static_cast<int>(getOrigin().x), static_cast<int>(getOrigin().y) };
-
-    auto const flip = jt::getFlipFromScale(m_scale);
     auto col = getShadowColor();
     col.a = std::min(col.a, m_color.a);
-    setSDLColor(col);
-    SDL_RenderCopyEx(sptr.get(), m_textTexture.get(), nullptr, &destRect, getRotation(), &p, flip);
+    drawGlyphs(sptr, getShadowOffset(), col);
 }
 
 void Text::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
-        return;
-    }
-    SDL_Point const p { static_cast<int>(getOrigin().x), static_cast<int>(getOrigin().y) };
-
-    auto const flip = jt::getFlipFromScale(m_scale);
     auto col = getOutlineColor();
     col.a = std::min(col.a, m_color.a);
-    setSDLColor(col);
-
-    for (auto const& outlineOffset : getOutlineOffsets()) {
-        auto const destRect = getDestRect(outlineOffset);
-
-        SDL_RenderCopyEx(
-            sptr.get(), m_textTexture.get(), nullptr, &destRect, getRotation(), &p, flip);
+    auto const width = getOutlineWidth();
+    if (width <= 0 || !updateOutlineTexture(sptr, width)) [[unlikely]] {
+        for (auto const& outlineOffset : getOutlineOffsets()) {
+            drawGlyphs(sptr, outlineOffset, col);
+        }
+        return;
     }
+
+    // one quad covering the silhouette, which is larger than the text by the outline width in
+    // every direction
+    auto const border = static_cast<float>(width);
+    auto const right = static_cast<float>(m_textTextureSizeX) + border;
+    auto const bottom = static_cast<float>(m_textTextureSizeY) + border;
+    SDL_Color const white { 255u, 255u, 255u, 255u };
+    std::array<SDL_Vertex, 4> const quad {
+        SDL_Vertex { SDL_FPoint { -border, -border }, white, SDL_FPoint { 0.0f, 0.0f } },
+        SDL_Vertex { SDL_FPoint { right, -border }, white, SDL_FPoint { 1.0f, 0.0f } },
+        SDL_Vertex { SDL_FPoint { right, bottom }, white, SDL_FPoint { 1.0f, 1.0f } },
+        SDL_Vertex { SDL_FPoint { -border, bottom }, white, SDL_FPoint { 0.0f, 1.0f } },
+    };
+    std::array<int, 6> const quadIndices { 0, 1, 2, 0, 2, 3 };
+    drawGeometry(sptr, m_outlineTexture.get(), quad, quadIndices, jt::Vector2f { 0.0f, 0.0f }, col);
 }
 
 void Text::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
-        return;
-    }
-    auto const destRect = getDestRect();
-    SDL_Point const p { static_cast<int>(getOrigin().x), static_cast<int>(getOrigin().y) };
-
-    setSDLColor(getColor());
-    SDL_RenderCopyEx(sptr.get(), m_textTexture.get(), nullptr, &destRect, getRotation(), &p,
-        jt::getFlipFromScale(m_scale));
+    drawGlyphs(sptr, jt::Vector2f { 0.0f, 0.0f }, getColor());
 }
 
 void Text::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
-        return;
-    }
-    auto const destRect = getDestRect();
-    SDL_Point const p { static_cast<int>(getOrigin().x), static_cast<int>(getOrigin().y) };
-
-    setSDLColor(getFlashColor());
-    SDL_RenderCopyEx(sptr.get(), m_textTexture.get(), nullptr, &destRect, getRotation(), &p,
-        jt::getFlipFromScale(m_scale));
+    drawGlyphs(sptr, jt::Vector2f { 0.0f, 0.0f }, getFlashColor());
 }
 
 void Text::doRotate(float /*rot*/) noexcept
@@ -143,108 +124,175 @@ void Text::doRotate(float /*rot*/) noexcept
     // Nothing to do here
 }
 
-void Text::renderOneLineOfText(std::shared_ptr<jt::RenderTargetLayer> const sptr, std::string text,
-    std::size_t i, std::size_t lineCount) const
+void Text::updateGlyphLayout()
 {
-    // render text on full white, so coloring can be done afterwards
-    SDL_Color const col { 255u, 255u, 255u, 255u };
-    SDL_Surface* textSurface = TTF_RenderText_Solid(m_font, text.c_str(), col);
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(
-        sptr.get(), textSurface); // now you can convert it into a texture
-
-    int w { 0 };
-    int h { 0 };
-    SDL_QueryTexture(
-        textTexture, nullptr, nullptr, &w, &h); // get the width and height of the texture
-
-    jt::Vector2f alignOffset {};
-    if (lineCount != 0 && m_textAlign == TextAlign::CENTER) {
-        alignOffset.x
-            = static_cast<float>(m_textTextureSizeX) / 2.0f - static_cast<float>(w) / 2.0f;
+    m_outlineTexture = nullptr;
+    m_glyphVertices.clear();
+    m_glyphIndices.clear();
+    m_textTextureSizeX = 0;
+    m_textTextureSizeY = 0;
+    if (!m_atlas || m_text.empty()) {
+        return;
     }
-    jt::Vector2f const pos = jt::Vector2f { 0, static_cast<float>(h * i) } + alignOffset;
-
-    SDL_Rect destRect; // create a rect
-    destRect.x = static_cast<int>(pos.x); // controls the rect's x coordinate
-    destRect.y = static_cast<int>(pos.y); // controls the rect's y coordinte
-    destRect.w = static_cast<int>(w); // controls the width of the rect
-    destRect.h = static_cast<int>(h); // controls the height of the rect
-
-    SDL_RenderCopy(sptr.get(), textTexture, nullptr, &destRect);
 
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    auto const lines = strutil::split(m_text, '\n');
+    std::vector<int> lineWidths {};
+    lineWidths.reserve(lines.size());
+    for (auto const& line : lines) {
+        int width { 0 };
+        char previous { '\0' };
+        for (auto const c : line) {
+            if (auto const* glyph = m_atlas->getGlyph(c)) {
+                if (previous != '\0') {
+                    width += m_atlas->getKerning(previous, c);
+                }
+                width += glyph->advance;
+                previous = c;
+            }
+        }
+        lineWidths.push_back(width);
+    }
+    auto const lineHeight = m_atlas->getLineHeight();
+    m_textTextureSizeX = lineWidths.empty()
+        ? 0
+        : *std::max_element(lineWidths.cbegin(), lineWidths.cend());
+    m_textTextureSizeY = static_cast<int>(lines.size()) * lineHeight;
+
+    auto const atlasSize = m_atlas->getTextureSize();
+    SDL_Color const white { 255u, 255u, 255u, 255u };
+    for (std::size_t i = 0; i != lines.size(); ++i) {
+        auto x = 0.0f;
+        if (m_textAlign == TextAlign::CENTER) {
+            x = static_cast<float>(static_cast<int>(static_cast<float>(m_textTextureSizeX) / 2.0f
+                - static_cast<float>(lineWidths[i]) / 2.0f));
+        }
+        auto const y = static_cast<float>(static_cast<int>(i) * lineHeight);
+
+        char previous { '\0' };
+        for (auto const c : lines[i]) {
+            auto const* glyph = m_atlas->getGlyph(c);
+            if (!glyph) {
+                continue;
+            }
+            if (previous != '\0') {
+                x += static_cast<float>(m_atlas->getKerning(previous, c));
+            }
+            previous = c;
+            auto const& rect = glyph->sourceRect;
+            auto const first = static_cast<int>(m_glyphVertices.size());
+            auto const right = x + static_cast<float>(rect.w);
+            auto const bottom = y + static_cast<float>(rect.h);
+            auto const u0 = static_cast<float>(rect.x) / atlasSize.x;
+            auto const v0 = static_cast<float>(rect.y) / atlasSize.y;
+            auto const u1 = static_cast<float>(rect.x + rect.w) / atlasSize.x;
+            auto const v1 = static_cast<float>(rect.y + rect.h) / atlasSize.y;
+            m_glyphVertices.push_back(SDL_Vertex { SDL_FPoint { x, y }, white, { u0, v0 } });
+            m_glyphVertices.push_back(SDL_Vertex { SDL_FPoint { right, y }, white, { u1, v0 } });
+            m_glyphVertices.push_back(
+                SDL_Vertex { SDL_FPoint { right, bottom }, white, { u1, v1 } });
+            m_glyphVertices.push_back(SDL_Vertex { SDL_FPoint { x, bottom }, white, { u0, v1 } });
+            for (auto const index : { 0, 1, 2, 0, 2, 3 }) {
+                m_glyphIndices.push_back(first + index);
+            }
+            x += static_cast<float>(glyph->advance);
+        }
+    }
 }
 
-jt::Vector2u Text::getSizeForLine(
-    std::shared_ptr<jt::RenderTargetLayer> const sptr, std::string const& text) const
+void Text::drawGlyphs(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+    jt::Vector2f const& positionOffset, jt::Color const& col) const
 {
-    SDL_Color const col { 255u, 255u, 255u, 255u };
-    SDL_Surface* textSurface = TTF_RenderText_Solid(m_font, text.c_str(), col);
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(
-        sptr.get(), textSurface); // now you can convert it into a texture
-    int w { 0 };
-    int h { 0 };
-    SDL_QueryTexture(
-        textTexture, nullptr, nullptr, &w, &h); // get the width and height of the texture
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
-    return jt::Vector2u { static_cast<unsigned int>(w), static_cast<unsigned int>(h) };
+    if (!m_atlas) [[unlikely]] {
+        return;
+    }
+    drawGeometry(sptr, m_atlas->getTexture(), m_glyphVertices, m_glyphIndices, positionOffset, col);
 }
 
-void Text::recreateTextTexture(std::shared_ptr<jt::RenderTargetLayer> const sptr)
+void Text::drawGeometry(std::shared_ptr<jt::RenderTargetLayer> const& sptr, SDL_Texture* texture,
+    std::span<SDL_Vertex const> vertices, std::span<int const> indices,
+    jt::Vector2f const& positionOffset, jt::Color const& col) const
 {
-    if (!m_font) {
-        std::cout << "no font loaded\n";
+    if (!sptr || !texture || vertices.empty()) [[unlikely]] {
         return;
     }
-    if (m_text.empty()) {
-        std::cout << "no text set loaded\n";
-        return;
+
+    auto const destRect = getDestRect(positionOffset);
+    auto const topLeft = jt::Vector2f { static_cast<float>(destRect.x),
+        static_cast<float>(destRect.y) };
+    auto const scale = jt::Vector2f { std::fabs(m_scale.x), std::fabs(m_scale.y) };
+    auto const size = jt::Vector2f { static_cast<float>(m_textTextureSizeX) * scale.x,
+        static_cast<float>(m_textTextureSizeY) * scale.y };
+    auto const flip = jt::getFlipFromScale(m_scale);
+    auto const rotation = getRotation();
+    SDL_Color const color { col.r, col.g, col.b, col.a };
+
+    // same transformation as SDL_RenderCopyEx: flip inside the destination rect, then rotate
+    // around the origin
+    m_drawVertices.resize(vertices.size());
+    for (std::size_t i = 0; i != vertices.size(); ++i) {
+        auto const& in = vertices[i];
+        jt::Vector2f p { in.position.x * scale.x, in.position.y * scale.y };
+        if (flip & SDL_FLIP_HORIZONTAL) {
+            p.x = size.x - p.x;
+        }
+        if (flip & SDL_FLIP_VERTICAL) {
+            p.y = size.y - p.y;
+        }
+        if (rotation != 0.0f) {
+            p = getOrigin() + jt::MathHelper::rotateBy(p - getOrigin(), rotation);
+        }
+        m_drawVertices[i]
+            = SDL_Vertex { SDL_FPoint { topLeft.x + p.x, topLeft.y + p.y }, color, in.tex_coord };
     }
-    if (!sptr) {
-        std::cout << "no valid render target in recreateTextTexture" << std::endl;
-        return;
+
+    SDL_RenderGeometry(sptr.get(), texture, m_drawVertices.data(),
+        static_cast<int>(m_drawVertices.size()), indices.data(), static_cast<int>(indices.size()));
+}
+
+bool Text::updateOutlineTexture(std::shared_ptr<jt::RenderTargetLayer> const& sptr, int width) const
+{
+    if (m_outlineTexture && m_outlineTextureWidth == width) [[likely]] {
+        return true;
+    }
+    m_outlineTexture = nullptr;
+    if (!sptr || !m_atlas || m_glyphVertices.empty()) {
+        return false;
     }
-    auto const ssv = strutil::split(m_text, '\n');
-    calculateTextTextureSize(sptr, ssv);
 
-    auto* oldT = SDL_GetRenderTarget(sptr.get());
+    auto const w = m_textTextureSizeX + 2 * width;
+    auto const h = m_textTextureSizeY + 2 * width;
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
-    m_textTexture = std::shared_ptr<SDL_Texture>(
-        SDL_CreateTexture(sptr.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
-            m_textTextureSizeX, m_textTextureSizeY),
+    auto outline = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(sptr.get(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
-
-    SDL_SetTextureBlendMode(m_textTexture.get(), SDL_BLENDMODE_BLEND);
-    SDL_SetRenderTarget(sptr.get(), m_textTexture.get());
-    // fill m_textTexture with transparent color, before rendering any text.
-    SDL_SetRenderDrawColor(sptr.get(), 0, 0, 0, 0);
-    SDL_RenderFillRect(sptr.get(), nullptr);
-
-    // draw text line by line
-    for (std::size_t i = 0; i != ssv.size(); ++i) {
-        renderOneLineOfText(sptr, ssv.at(i), i, ssv.size());
+    if (!outline) {
+        return false;
     }
-    // reset the renderer to the old texture
-    SDL_SetRenderTarget(sptr.get(), oldT);
-}
-
-std::shared_ptr<jt::RenderTargetLayer> Text::getRenderTarget()
-{
-    if (m_rendertarget.expired()) {
-        std::cout << "Cannot use Text without valid renderTarget\n";
-        return nullptr;
+    SDL_SetTextureBlendMode(outline.get(), SDL_BLENDMODE_BLEND);
+
+    jt::RenderStateScope const renderState { sptr.get() };
+    SDL_SetRenderTarget(sptr.get(), outline.get());
+    SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(sptr.get(), 255u, 255u, 255u, 0u);
+    SDL_RenderClear(sptr.get());
+
+    // glyphs are white, so blending them onto the cleared texture only accumulates alpha
+    std::vector<SDL_Vertex> stamp { m_glyphVertices };
+    for (auto x = 0; x <= 2 * width; ++x) {
+        for (auto y = 0; y <= 2 * width; ++y) {
+            for (std::size_t i = 0; i != stamp.size(); ++i) {
+                stamp[i].position.x = m_glyphVertices[i].position.x + static_cast<float>(x);
+                stamp[i].position.y = m_glyphVertices[i].position.y + static_cast<float>(y);
+            }
+            SDL_RenderGeometry(sptr.get(), m_atlas->getTexture(), stamp.data(),
+                static_cast<int>(stamp.size()), m_glyphIndices.data(),
+                static_cast<int>(m_glyphIndices.size()));
+        }
     }
-    return m_rendertarget.lock();
-}
 
-void Text::setSDLColor(jt::Color const& col) const
-{
-    SDL_SetTextureColorMod(m_textTexture.get(), col.r, col.g, col.b);
-    SDL_SetTextureAlphaMod(m_textTexture.get(), col.a);
+    m_outlineTexture = outline;
+    m_outlineTextureWidth = width;
+    return true;
 }
 
 SDL_Rect Text::getDestRect(jt::Vector2f const& positionOffset) const
@@ -271,20 +319,4 @@ SDL_Rect Text::getDestRect(jt::Vector2f const& positionOffset) const
     return destRect;
 }
 
-void Text::calculateTextTextureSize(
-    std::shared_ptr<jt::RenderTargetLayer> const sptr, std::vector<std::string> const& ssv)
-{
-    unsigned int maxLineLengthInPixel { 0u };
-    std::size_t maxLineLengthInChars { 0u };
-    for (auto const& l : ssv) {
-        if (l.size() > maxLineLengthInChars) {
-            maxLineLengthInPixel = getSizeForLine(sptr, l).x;
-            maxLineLengthInChars = l.size();
-        }
-    }
-
-    m_textTextureSizeX = static_cast<int>(maxLineLengthInPixel);
-    m_textTextureSizeY = static_cast<int>(ssv.size()) * TTF_FontHeight(m_font);
-}
-
 } // namespace jt
@@ -1,10 +1,13 @@
 ﻿#ifndef JAMTEMPLATE_TEXT_HPP
 #define JAMTEMPLATE_TEXT_HPP
 
+#include <cache/font_cache_interface.hpp>
 #include <drawable_impl_sdl.hpp>
+#include <glyph_atlas.hpp>
 #include <render_target_layer.hpp>
 #include <sdl_2_include.hpp>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -16,15 +19,14 @@ public:
 
     using Sptr = std::shared_ptr<Text>;
 
-    ~Text() override;
-
     /// load Font
     /// \param fontFileName filename to the font (ttf)
     /// \param characterSize size in characters
     /// \param rendertarget_wptr the rendertarget (unused for sfml, but needed for sdl
     /// compatibility)
+    /// \param fontCache the font cache, texts with the same font and size share the font
     void loadFont(std::string const& fontFileName, unsigned int characterSize,
-        std::weak_ptr<jt::RenderTargetLayer> wptr);
+        std::weak_ptr<jt::RenderTargetLayer> wptr, jt::FontCacheInterface& fontCache);
 
     /// set the text
     /// \param text the text to be displayed
@@ -56,7 +58,7 @@ public:
     jt::Vector2f getScale() const noexcept override;
 
 private:
-    TTF_Font* m_font { nullptr };
+    std::shared_ptr<jt::GlyphAtlas> m_atlas { nullptr };
     std::string m_text { "" };
 
     TextAlign m_textAlign { TextAlign::CENTER };
@@ -64,22 +66,21 @@ private:
     jt::Vector2f m_position { 0, 0 };
     jt::Color m_color { jt::colors::White };
 
-    // optimization, so the text rendering logic does not have to happen in every frame, but only
-    // when the text changes.
-    mutable std::shared_ptr<SDL_Texture> m_textTexture { nullptr };
+    // optimization, so the text layout does not have to happen in every frame, but only when the
+    // text changes. Glyph quads in text coordinates, transformed and colored when drawing.
+    std::vector<SDL_Vertex> m_glyphVertices {};
+    std::vector<int> m_glyphIndices {};
+    mutable std::vector<SDL_Vertex> m_drawVertices {};
     int m_textTextureSizeX { 0 };
     int m_textTextureSizeY { 0 };
 
-    std::weak_ptr<jt::RenderTargetLayer> m_rendertarget;
+    // outline silhouette of the whole text, rendered when the outline is drawn first after the
+    // text changed, so the outline costs one draw call instead of one per outline offset
+    mutable std::shared_ptr<SDL_Texture> m_outlineTexture { nullptr };
+    mutable int m_outlineTextureWidth { 0 };
 
     void doUpdate(float /*elapsed*/) override;
 
-    void renderOneLineOfText(std::shared_ptr<jt::RenderTargetLayer> const sptr, std::string text,
-        std::size_t i, std::size_t lineCount) const;
-
-    jt::Vector2u getSizeForLine(
-        std::shared_ptr<jt::RenderTargetLayer> const sptr, std::string const& text) const;
-
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
@@ -87,13 +88,14 @@ private:
 
     void doRotate(float /*rot*/) noexcept override;
 
-    void recreateTextTexture(std::shared_ptr<jt::RenderTargetLayer> const sptr);
-    std::shared_ptr<jt::RenderTargetLayer> getRenderTarget();
-    void setSDLColor(jt::Color const& col) const;
+    void updateGlyphLayout();
+    void drawGlyphs(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+        jt::Vector2f const& positionOffset, jt::Color const& col) const;
+    void drawGeometry(std::shared_ptr<jt::RenderTargetLayer> const& sptr, SDL_Texture* texture,
+        std::span<SDL_Vertex const> vertices, std::span<int const> indices,
+        jt::Vector2f const& positionOffset, jt::Color const& col) const;
+    bool updateOutlineTexture(std::shared_ptr<jt::RenderTargetLayer> const& sptr, int width) const;
     SDL_Rect getDestRect(jt::Vector2f const& positionOffset = jt::Vector2f { 0.0f, 0.0f }) const;
-
-    void calculateTextTextureSize(
-        std::shared_ptr<jt::RenderTargetLayer> const sptr, std::vector<std::string> const& ssv);
 };
 } // namespace jt
 
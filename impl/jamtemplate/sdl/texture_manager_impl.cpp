@@ -1,66 +1,68 @@
 ﻿#include "texture_manager_impl.hpp"
-#include <aselib/image_builder.hpp>
+#include <aseprite_cache.hpp>
 #include <sdl_helper.hpp>
 #include <sprite_functions.hpp>
 #include <strutils.hpp>
 #include <SDL_image.h>
 #include <tracy/Tracy.hpp>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace jt {
 
 namespace {
 
-std::shared_ptr<SDL_Texture> createImageFromAse(
-    std::string const& filename, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+std::shared_ptr<SDL_Surface> createSurfaceFromAse(std::string const& filename)
 {
-    auto const asepritePos = filename.rfind(".aseprite");
-    auto const splittedFilename = filename.substr(0, asepritePos + 9);
-    auto const postFix = filename.substr(asepritePos + 9);
-    aselib::AsepriteData aseData { filename };
-
-    std::unique_ptr<aselib::Image> aseImage { nullptr };
-    if (strutil::contains(postFix, ".layer=")) {
-        auto const layerPos = postFix.find(".layer=");
-        auto const layerName = postFix.substr(layerPos + 7);
-        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
-    } else {
-        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
-        aseImage = std::make_unique<aselib::Image>(
-            aselib::makeImageFromAse(aseData, !ignore_transparent));
-    }
-
-    auto const w = aseImage->m_width;
-    auto const h = aseImage->m_height;
-    auto const wAsInt = static_cast<int>(w);
-    auto const hAsInt = static_cast<int>(h);
+    auto const decoded = jt::AsepriteCache::load(filename);
+
+    auto const wAsInt = static_cast<int>(decoded.width);
+    auto const hAsInt = static_cast<int>(decoded.height);
     std::shared_ptr<SDL_Surface> image = std::shared_ptr<SDL_Surface>(
         SDL_CreateRGBSurfaceWithFormat(0, wAsInt, hAsInt, 32, SDL_PIXELFORMAT_RGBA32),
         [](SDL_Surface* s) { SDL_FreeSurface(s); });
-
-    auto const transparent = SDL_MapRGBA(image->format, 0, 0, 0, 0);
-
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            jt::setPixel(image.get(), i, j, transparent);
-        }
+    if (!image) {
+        throw std::invalid_argument { "cannot create surface for '" + filename + "'" };
     }
+    // decoded pixels have the same layout as the surface
+    jt::copyPixelsRGBA32(image.get(), decoded.pixels.data());
+    return image;
+}
 
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            auto const& p = aseImage->getPixelAt(i, j);
-            auto const col = SDL_MapRGBA(image->format, p.r, p.g, p.b, p.a);
-            jt::setPixel(image.get(), i, j, col);
-        }
-    }
+std::shared_ptr<SDL_Texture> createTextureFromSurface(
+    std::shared_ptr<SDL_Surface> const& image, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
     return std::shared_ptr<SDL_Texture>(
         SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
+std::shared_ptr<SDL_Texture> createImageFromAse(
+    std::string const& filename, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    return createTextureFromSurface(createSurfaceFromAse(filename), renderTarget);
+}
+
+// runs on worker threads, so only the surface is created here and the renderer is not touched
+std::shared_ptr<SDL_Surface> decodeSurface(std::string const& str)
+{
+    if (strutil::contains(str, ".aseprite")) {
+        return createSurfaceFromAse(str);
+    }
+    auto image = jt::loadImage(str);
+    if (!image) {
+        throw std::invalid_argument { "invalid filename, cannot load texture from '" + str + "'" };
+    }
+    return image;
+}
+
 std::shared_ptr<SDL_Texture> createButtonImage(
     std::array<std::string, 3> const& ssv, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
 {
@@ -184,30 +186,64 @@ std::shared_ptr<SDL_Texture> createRingImage(
     return SpriteFunctions::makeRing(renderTarget, ringImageSize);
 }
 
+std::shared_ptr<SDL_Texture> createStripImage(
+    std::array<std::string, 7> const& ssv, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    if (ssv.at(1) != "h" && ssv.at(1) != "v") {
+        throw std::invalid_argument { "invalid strip orientation" };
+    }
+    std::size_t count { 0 };
+    auto const w = std::stol(ssv.at(5), &count);
+    if (count != ssv.at(5).size() || w <= 0) {
+        throw std::invalid_argument { "invalid strip w" };
+    }
+    auto const h = std::stol(ssv.at(6), &count);
+    if (count != ssv.at(6).size() || h <= 0) {
+        throw std::invalid_argument { "invalid strip h" };
+    }
+
+    std::array<std::shared_ptr<SDL_Surface>, 3> pieces {};
+    for (auto i = 0u; i != pieces.size(); ++i) {
+        auto const& fileName = ssv.at(i + 2);
+        pieces[i] = jt::loadImage(fileName);
+        if (!pieces[i]) {
+            throw std::invalid_argument { "invalid filename, cannot load strip piece from '"
+                + fileName + "'" };
+        }
+    }
+    return SpriteFunctions::makeStripImage(renderTarget, pieces[0].get(), pieces[1].get(),
+        pieces[2].get(), static_cast<unsigned int>(w), static_cast<unsigned int>(h),
+        ssv.at(1) == "h");
+}
+
+// files can have any pixel format, with 32 bit rgba all pixels are processed the same way
+std::shared_ptr<SDL_Surface> convertToRGBA32(std::shared_ptr<SDL_Surface> const& image)
+{
+    if (!image || image->format->format == SDL_PIXELFORMAT_RGBA32) {
+        return image;
+    }
+    return std::shared_ptr<SDL_Surface>(
+        SDL_ConvertSurfaceFormat(image.get(), SDL_PIXELFORMAT_RGBA32, 0),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+}
+
 std::shared_ptr<SDL_Texture> createFlashImage(
     std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
 {
-    auto image = std::shared_ptr<SDL_Surface>(
-        IMG_Load(str.c_str()), [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    // decoded again on the cpu instead of reading back the texture from the gpu
+    auto const image = convertToRGBA32(
+        strutil::contains(str, ".aseprite") ? createSurfaceFromAse(str) : jt::loadImage(str));
     if (!image) {
         return nullptr;
     }
-    int const w = image->w;
-    int const h = image->h;
 
     auto const white = SDL_MapRGBA(image->format, 255u, 255u, 255u, 255u);
-
-    for (int x = 0; x != w; ++x) {
-        for (int y = 0; y != h; ++y) {
-
-            uint8_t r = 0u;
-            uint8_t g = 0u;
-            uint8_t b = 0u;
-            uint8_t a = 0u;
-            SDL_GetRGBA(jt::getPixel(image.get(), x, y), image->format, &r, &g, &b, &a);
-            if (a != 0) {
-                jt::setPixel(image.get(), x, y, white);
-            }
+    auto const alphaMask = image->format->Amask;
+    for (int y = 0; y != image->h; ++y) {
+        auto* const row = jt::getPixelRow(image.get(), y);
+        // branchless, so the compiler can vectorize the loop
+        for (int x = 0; x != image->w; ++x) {
+            row[x] = (row[x] & alphaMask) != 0u ? white : row[x];
         }
     }
 
@@ -223,7 +259,9 @@ std::shared_ptr<SDL_Texture> loadTextureFromDisk(
     if (renderTarget == nullptr) {
         throw std::logic_error { "rendertarget is null in loadTextureFromDisk" };
     }
-    auto texture = std::shared_ptr<SDL_Texture>(IMG_LoadTexture(renderTarget.get(), str.c_str()),
+    auto const type = jt::getImageType(str);
+    auto texture = std::shared_ptr<SDL_Texture>(
+        IMG_LoadTextureTyped_RW(renderTarget.get(), jt::openFile(str), 1, type.c_str()),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 
     if (texture == nullptr) {
@@ -231,6 +269,65 @@ std::shared_ptr<SDL_Texture> loadTextureFromDisk(
     }
     return texture;
 }
+std::shared_ptr<jt::IndexedImage const> createIndexedImage(std::string const& fileName)
+{
+    auto const image = convertToRGBA32(decodeSurface(fileName));
+    if (!image) {
+        throw std::invalid_argument { "cannot convert '" + fileName + "' to rgba" };
+    }
+    // rows of the surface can be padded
+    auto const rowSize = static_cast<std::size_t>(image->w) * 4u;
+    std::vector<std::uint8_t> rgba(rowSize * static_cast<std::size_t>(image->h));
+    for (int y = 0; y != image->h; ++y) {
+        std::memcpy(rgba.data() + static_cast<std::size_t>(y) * rowSize,
+            jt::getPixelRow(image.get(), y), rowSize);
+    }
+    return std::make_shared<jt::IndexedImage const>(static_cast<unsigned int>(image->w),
+        static_cast<unsigned int>(image->h), rgba.data());
+}
+
+void uploadIndexedImage(
+    SDL_Texture* texture, jt::IndexedImage const& image, jt::Palette const& palette)
+{
+    auto const rgba = image.toRGBA(palette);
+    SDL_UpdateTexture(texture, nullptr, rgba.data(), static_cast<int>(image.getWidth() * 4u));
+}
+
+std::shared_ptr<SDL_Texture> createTextureFromIndexedImage(jt::IndexedImage const& image,
+    jt::Palette const& palette, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    auto texture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(renderTarget.get(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+            static_cast<int>(image.getWidth()), static_cast<int>(image.getHeight())),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    if (!texture) {
+        throw std::logic_error { "cannot create texture for indexed image" };
+    }
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+    uploadIndexedImage(texture.get(), image, palette);
+    return texture;
+}
+
+// the web build is not linked with pthreads, there the decoding is done by uploadPrefetched()
+#if JT_ENABLE_WEB
+constexpr auto decodeLaunchPolicy { std::launch::deferred };
+#else
+constexpr auto decodeLaunchPolicy { std::launch::async };
+#endif
+
+// prefetched textures are kept for about ten seconds at 60 fps while the budget is exceeded, after
+// that they are evicted like all other unused textures
+constexpr std::uint32_t prefetchGraceEvictions { 600u };
+
+constexpr std::string_view flashPostfix { "___flash__" };
+constexpr std::string_view palettePostfix { ".palette=" };
+
+bool isDecodedFromFile(std::string const& str)
+{
+    return !str.starts_with('#') && !str.ends_with(flashPostfix)
+        && !strutil::contains(str, palettePostfix);
+}
+
 } // namespace
 
 TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer)
@@ -251,62 +348,308 @@ std::shared_ptr<SDL_Texture> TextureManagerImpl::get(std::string const& str)
         throw std::logic_error { "renderer not available for TextureManager::get()" };
     }
 
+    // flash versions of generated images are the images themselves
+    if (str.starts_with('#') && str.ends_with(flashPostfix)) {
+        return get(str.substr(0, str.size() - flashPostfix.size()));
+    }
+    // palette swaps do not change the silhouette, so all swaps share the flash image of the file
+    if (auto const pos = str.rfind(palettePostfix);
+        pos != std::string::npos && str.ends_with(flashPostfix)) {
+        return get(str.substr(0, pos) + std::string { flashPostfix });
+    }
+
     // check if texture is already stored in texture manager
-    if (containsTexture(str)) {
+    jt::StringId const id { str };
+    if (auto const it = m_textures.find(id); it != m_textures.end()) {
         ZoneColor(tracy::Color::AntiqueWhite2);
-        return m_textures[str];
+        it->second.lastUse = ++m_useCounter;
+        it->second.prefetchGrace = 0u;
+        return it->second.texture;
+    }
+
+    return store(id, createTexture(str, renderer));
+}
+
+std::shared_ptr<SDL_Texture> TextureManagerImpl::createTexture(
+    std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderer)
+{
+    // a prefetch of this texture is still running, so wait for it instead of decoding again
+    if (auto const pending = m_pendingDecodes.find(str); pending != m_pendingDecodes.end()) {
+        auto decode = std::move(pending->second);
+        m_pendingDecodes.erase(pending);
+        return createTextureFromSurface(decode.get(), renderer);
+    }
+
+    // flash images are only created when they are requested, which is usually the first time a
+    // drawable flashes, so textures that never flash are not kept in memory twice
+    if (str.ends_with(flashPostfix)) {
+        return createFlashImage(str.substr(0, str.size() - flashPostfix.size()), renderer);
+    }
+
+    if (strutil::contains(str, palettePostfix)) {
+        return createPaletteTexture(str, renderer);
     }
 
     // Check if special ase parsing is required
     if (strutil::contains(str, ".aseprite")) {
-        m_textures[str] = createImageFromAse(str, renderer);
-        m_textures[getFlashName(str)] = createFlashImage(str, renderer);
-        return m_textures[str];
+        return createImageFromAse(str, renderer);
     }
 
     // normal filenames do not start with a '#'
     if (!str.starts_with('#')) {
-        m_textures[str] = loadTextureFromDisk(str, m_renderer.lock());
-        // create Flash Image
-        m_textures[getFlashName(str)] = createFlashImage(str, m_renderer.lock());
-        return m_textures[str];
+        return loadTextureFromDisk(str, renderer);
     }
 
     if (str.at(1) == 'b') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createButtonImage(ssv, renderer);
+        return createButtonImage(ssv, renderer);
     } else if (str.at(1) == 'f') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createBlankImage(ssv, renderer);
+        return createBlankImage(ssv, renderer);
     } else if (str.at(1) == 'g') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createGlowImage(ssv, renderer);
+        return createGlowImage(ssv, renderer);
     } else if (str.at(1) == 'v') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createVignetteImage(ssv, renderer);
+        return createVignetteImage(ssv, renderer);
     } else if (str.at(1) == 'x') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createRectImage(ssv, renderer);
+        return createRectImage(ssv, renderer);
     } else if (str.at(1) == 'c') {
         auto ssv = strutil::split<2>(str.substr(1u), '#');
-        m_textures[str] = createCircleImage(ssv, renderer);
+        return createCircleImage(ssv, renderer);
     } else if (str.at(1) == 'r') {
         auto ssv = strutil::split<2>(str.substr(1u), '#');
-        m_textures[str] = createRingImage(ssv, renderer);
-    } else {
-        throw std::invalid_argument("ERROR: cannot get texture with name " + str);
+        return createRingImage(ssv, renderer);
+    } else if (str.at(1) == 's') {
+        auto ssv = strutil::split<7>(str.substr(1u), '#');
+        return createStripImage(ssv, renderer);
     }
+    throw std::invalid_argument("ERROR: cannot get texture with name " + str);
+}
 
-    // create Flash Image
-    m_textures[getFlashName(str)] = m_textures[str];
+std::shared_ptr<SDL_Texture> TextureManagerImpl::store(
+    jt::StringId id, std::shared_ptr<SDL_Texture> const& texture)
+{
+    int w { 0 };
+    int h { 0 };
+    SDL_QueryTexture(texture.get(), nullptr, nullptr, &w, &h);
+    // all textures are created with 32 bit pixel formats
+    auto const bytes = static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4u;
+    m_textures[id] = TextureEntry { texture, bytes, ++m_useCounter };
+    m_memoryUsage += bytes;
+    return texture;
+}
+
+std::shared_ptr<SDL_Texture> TextureManagerImpl::createPaletteTexture(
+    std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderer)
+{
+    auto const pos = str.rfind(palettePostfix);
+    jt::StringId const swapId { std::string_view { str }.substr(pos + palettePostfix.size()) };
+    auto const swap = m_paletteSwaps.find(swapId);
+    if (swap == m_paletteSwaps.cend()) {
+        throw std::invalid_argument { "palette swap for '" + str + "' is not set" };
+    }
 
-    return m_textures[str];
+    auto const image = getIndexedImage(str.substr(0, pos));
+    auto const texture = createTextureFromIndexedImage(*image,
+        image->getPalette().swapped(swap->second.source, swap->second.target), renderer);
+    m_paletteTextures[str] = PaletteTexture { image, swapId, texture };
+    return texture;
 }
 
-std::string TextureManagerImpl::getFlashName(std::string const& str) { return str + "___flash__"; }
+std::shared_ptr<jt::IndexedImage const> TextureManagerImpl::getIndexedImage(
+    std::string const& fileName)
+{
+    auto& entry = m_indexedImages[fileName];
+    if (auto image = entry.lock()) {
+        return image;
+    }
+    auto image = createIndexedImage(fileName);
+    entry = image;
+    return image;
+}
 
-void TextureManagerImpl::reset() { m_textures.clear(); }
+void TextureManagerImpl::setPaletteSwap(
+    std::string const& name, jt::Palette const& source, jt::Palette const& target)
+{
+    ZoneScopedN("jt::TextureManagerImpl::setPaletteSwap");
+    if (source.size() != target.size()) {
+        throw std::invalid_argument { "source and target palette need to have the same size" };
+    }
+    jt::StringId const swapId { name };
+    m_paletteSwaps[swapId] = PaletteSwap { source, target };
+
+    // the indices are kept, so existing textures are updated without decoding the files again
+    removeUnusedPaletteTextures();
+    for (auto const& kvp : m_paletteTextures) {
+        if (kvp.second.swap != swapId) {
+            continue;
+        }
+        auto const texture = kvp.second.texture.lock();
+        auto const& image = *kvp.second.image;
+        uploadIndexedImage(texture.get(), image, image.getPalette().swapped(source, target));
+    }
+}
+
+void TextureManagerImpl::removeUnusedPaletteTextures()
+{
+    std::erase_if(m_paletteTextures, [](auto const& kvp) { return kvp.second.texture.expired(); });
+    std::erase_if(m_indexedImages, [](auto const& kvp) { return kvp.second.expired(); });
+}
+
+void TextureManagerImpl::prefetch(std::string const& str)
+{
+    if (str.empty()) {
+        throw std::invalid_argument { "TextureManager prefetch: string must not be empty" };
+    }
+    if (!isDecodedFromFile(str) || containsTexture(str) || m_pendingDecodes.contains(str)
+        || m_failedDecodes.contains(str)) {
+        return;
+    }
+    m_pendingDecodes[str] = std::async(decodeLaunchPolicy, [str]() { return decodeSurface(str); });
+}
+
+std::shared_ptr<SDL_Texture> TextureManagerImpl::getAsync(std::string const& str)
+{
+    if (containsTexture(str) || !isDecodedFromFile(str) || m_failedDecodes.contains(str)) {
+        return get(str);
+    }
+    prefetch(str);
+
+    if (!m_placeholder) {
+        auto renderer = m_renderer.lock();
+        if (!renderer) {
+            throw std::logic_error { "renderer not available for TextureManager::getAsync()" };
+        }
+        auto const image = std::shared_ptr<SDL_Surface>(
+            SDL_CreateRGBSurfaceWithFormat(0, 1, 1, 32, SDL_PIXELFORMAT_RGBA32),
+            [](SDL_Surface* s) { SDL_FreeSurface(s); });
+        SDL_FillRect(image.get(), nullptr, SDL_MapRGBA(image->format, 0, 0, 0, 0));
+        m_placeholder = createTextureFromSurface(image, renderer);
+        SDL_SetTextureBlendMode(m_placeholder.get(), SDL_BLENDMODE_BLEND);
+    }
+    return m_placeholder;
+}
+
+bool TextureManagerImpl::isLoaded(std::string const& str) const { return m_textures.contains(str); }
+
+void TextureManagerImpl::uploadPrefetched(float timeBudget)
+{
+    ZoneScopedN("jt::TextureManagerImpl::uploadPrefetched");
+    auto renderer = m_renderer.lock();
+    if (!renderer || m_pendingDecodes.empty()) {
+        return;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    for (auto it = m_pendingDecodes.begin(); it != m_pendingDecodes.end();) {
+        // deferred decodes are run here, on the main thread
+        if (it->second.wait_for(std::chrono::seconds { 0 }) == std::future_status::timeout) {
+            ++it;
+            continue;
+        }
+        auto const id = it->first;
+        auto decode = std::move(it->second);
+        it = m_pendingDecodes.erase(it);
+        try {
+            store(id, createTextureFromSurface(decode.get(), renderer));
+            m_textures[id].prefetchGrace = prefetchGraceEvictions;
+        } catch (std::exception const& e) {
+            // a failed prefetch must not stop the game, get() reports the error to the caller
+            std::cout << "Warning: prefetching texture failed: " << e.what() << std::endl;
+            m_failedDecodes.insert(id);
+        }
+
+        std::chrono::duration<float> const elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= timeBudget) {
+            return;
+        }
+    }
+}
+
+std::string TextureManagerImpl::getFlashName(std::string const& str)
+{
+    return str + std::string { flashPostfix };
+}
+
+std::shared_ptr<SDL_Texture> TextureManagerImpl::getOutline(
+    std::string const& str, jt::Recti const& rect, int width)
+{
+    if (width <= 0) {
+        throw std::invalid_argument { "outline width must be positive" };
+    }
+    auto const outlineName = str + "___outline__" + std::to_string(rect.left) + "#"
+        + std::to_string(rect.top) + "#" + std::to_string(rect.width) + "#"
+        + std::to_string(rect.height) + "#" + std::to_string(width);
+    if (auto const it = m_textures.find(outlineName); it != m_textures.end()) {
+        it->second.lastUse = ++m_useCounter;
+        return it->second.texture;
+    }
+
+    auto const texture = get(str);
+    auto outline = SpriteFunctions::makeOutlineImage(m_renderer.lock(), texture.get(),
+        SDL_Rect { rect.left, rect.top, rect.width, rect.height }, width);
+    if (!outline) {
+        // a failed silhouette is not cached, so the next call retries
+        return nullptr;
+    }
+    return store(outlineName, outline);
+}
+
+void TextureManagerImpl::reset()
+{
+    // waits for running decodes
+    m_pendingDecodes.clear();
+    m_failedDecodes.clear();
+    m_textures.clear();
+    m_paletteTextures.clear();
+    m_indexedImages.clear();
+    m_memoryUsage = 0u;
+}
 
 size_t TextureManagerImpl::getNumberOfTextures() noexcept { return m_textures.size(); }
 
+std::size_t TextureManagerImpl::getMemoryUsage() const noexcept { return m_memoryUsage; }
+
+std::size_t TextureManagerImpl::getMemoryUsage(std::string const& str) const
+{
+    auto const it = m_textures.find(str);
+    return it == m_textures.cend() ? 0u : it->second.bytes;
+}
+
+void TextureManagerImpl::setMemoryBudget(std::size_t bytes) noexcept { m_memoryBudget = bytes; }
+
+void TextureManagerImpl::evictUnused()
+{
+    if (m_memoryBudget == 0u || m_memoryUsage <= m_memoryBudget) [[likely]] {
+        return;
+    }
+    ZoneScopedN("jt::TextureManagerImpl::evictUnused");
+
+    // textures only referenced by the texture manager are not used by any drawable
+    std::vector<decltype(m_textures)::iterator> unused {};
+    for (auto it = m_textures.begin(); it != m_textures.end(); ++it) {
+        if (it->second.texture.use_count() != 1) {
+            continue;
+        }
+        if (it->second.prefetchGrace != 0u) {
+            --it->second.prefetchGrace;
+            continue;
+        }
+        unused.push_back(it);
+    }
+    std::sort(unused.begin(), unused.end(),
+        [](auto const& a, auto const& b) { return a->second.lastUse < b->second.lastUse; });
+
+    for (auto const& it : unused) {
+        if (m_memoryUsage <= m_memoryBudget) {
+            break;
+        }
+        m_memoryUsage -= it->second.bytes;
+        m_textures.erase(it);
+    }
+    removeUnusedPaletteTextures();
+}
+
 } // namespace jt
@@ -1,11 +1,17 @@
 ﻿#ifndef JAMTEMPLATE_TEXTUREMANAGER_HPP
 #define JAMTEMPLATE_TEXTUREMANAGER_HPP
 
+#include <color/indexed_image.hpp>
 #include <render_target_layer.hpp>
 #include <sdl_2_include.hpp>
+#include <string_id.hpp>
 #include <texture_manager_interface.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 namespace jt {
@@ -15,18 +21,81 @@ public:
     explicit TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer);
     std::shared_ptr<SDL_Texture> get(std::string const& str) override;
 
+    void prefetch(std::string const& str) override;
+    std::shared_ptr<SDL_Texture> getAsync(std::string const& str) override;
+    bool isLoaded(std::string const& str) const override;
+    void uploadPrefetched(float timeBudget) override;
+
     // reset all stored images
     void reset() override;
 
     std::string getFlashName(std::string const& str) override;
 
+    std::shared_ptr<SDL_Texture> getOutline(
+        std::string const& str, jt::Recti const& rect, int width) override;
+
     std::size_t getNumberOfTextures() noexcept override;
 
+    std::size_t getMemoryUsage() const noexcept override;
+    std::size_t getMemoryUsage(std::string const& str) const override;
+    void setMemoryBudget(std::size_t bytes) noexcept override;
+    void evictUnused() override;
+
+    void setPaletteSwap(
+        std::string const& name, jt::Palette const& source, jt::Palette const& target) override;
+
 private:
-    std::map<std::string, std::shared_ptr<SDL_Texture>> m_textures;
+    struct TextureEntry {
+        std::shared_ptr<SDL_Texture> texture { nullptr };
+        std::size_t bytes { 0u };
+        // value of m_useCounter when the texture was requested the last time
+        std::uint64_t lastUse { 0u };
+        // prefetched but not requested yet: number of over budget evictUnused() calls the texture
+        // survives, so preloaded textures are not evicted before the first get()
+        std::uint32_t prefetchGrace { 0u };
+    };
+
+    std::map<jt::StringId, TextureEntry> m_textures;
     std::weak_ptr<jt::RenderTargetLayer> m_renderer;
 
-    bool containsTexture(std::string const& str) { return (m_textures.count(str) != 0); }
+    // surfaces decoded on worker threads, uploaded as textures on the main thread
+    std::map<jt::StringId, std::future<std::shared_ptr<SDL_Surface>>> m_pendingDecodes;
+    // prefetches which could not be decoded, get() loads them again to report the error
+    std::set<jt::StringId> m_failedDecodes;
+    std::shared_ptr<SDL_Texture> m_placeholder { nullptr };
+
+    struct PaletteSwap {
+        jt::Palette source {};
+        jt::Palette target {};
+    };
+
+    struct PaletteTexture {
+        std::shared_ptr<jt::IndexedImage const> image { nullptr };
+        jt::StringId swap {};
+        // textures are owned by m_textures and the drawables using them
+        std::weak_ptr<SDL_Texture> texture {};
+    };
+
+    std::map<jt::StringId, PaletteSwap> m_paletteSwaps;
+    // images are shared by all palette swapped textures of the same file
+    std::map<jt::StringId, std::weak_ptr<jt::IndexedImage const>> m_indexedImages;
+    std::map<jt::StringId, PaletteTexture> m_paletteTextures;
+
+    std::uint64_t m_useCounter { 0u };
+    std::size_t m_memoryUsage { 0u };
+    // 0 means unlimited
+    std::size_t m_memoryBudget { 0u };
+
+    bool containsTexture(std::string const& str) const { return m_textures.contains(str); }
+
+    std::shared_ptr<SDL_Texture> createTexture(
+        std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderer);
+    std::shared_ptr<SDL_Texture> store(
+        jt::StringId id, std::shared_ptr<SDL_Texture> const& texture);
+    std::shared_ptr<SDL_Texture> createPaletteTexture(
+        std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderer);
+    std::shared_ptr<jt::IndexedImage const> getIndexedImage(std::string const& fileName);
+    void removeUnusedPaletteTextures();
 };
 
 } // namespace jt
@@ -1,6 +1,8 @@
 #ifndef JAMTEMPLATE_TEXTURE_MANAGER_INTERFACE_HPP
 #define JAMTEMPLATE_TEXTURE_MANAGER_INTERFACE_HPP
 
+#include <color/palette.hpp>
+#include <rect.hpp>
 #include <sdl_2_include.hpp>
 #include <cstddef>
 #include <memory>
@@ -15,18 +17,82 @@ public:
     /// \return shared pointer to SDL_Texture
     virtual std::shared_ptr<SDL_Texture> get(std::string const& str) = 0;
 
+    /// start decoding a texture from file on a worker thread. The texture is uploaded by
+    /// uploadPrefetched(). Generated textures (starting with '#') are not prefetched. Web builds
+    /// have no worker threads, there the texture is decoded by uploadPrefetched() as well.
+    /// \param str texture identifier
+    virtual void prefetch(std::string const& str) = 0;
+
+    /// get texture for string without waiting for it to be decoded
+    /// \param str texture identifier
+    /// \return the texture if it is loaded, otherwise a transparent placeholder. Use isLoaded() to
+    /// check when the texture is available.
+    virtual std::shared_ptr<SDL_Texture> getAsync(std::string const& str) = 0;
+
+    /// check if a texture is loaded, i.e. get() does not need to decode it
+    /// \param str texture identifier
+    /// \return true if the texture is loaded
+    virtual bool isLoaded(std::string const& str) const = 0;
+
+    /// upload prefetched textures which finished decoding. Needs to be called from the main thread.
+    /// \param timeBudget time in seconds after which no further texture is uploaded. At least one
+    /// texture is uploaded if one is ready.
+    virtual void uploadPrefetched(float timeBudget) = 0;
+
     /// reset the texture manager
     virtual void reset() = 0;
 
-    /// get flash version of texture identifier
+    /// get flash version of texture identifier. The flash texture is only created when it is
+    /// requested via get() for the first time.
     /// \param str texture identifier
     /// \return texture identifier with flash postfix
     virtual std::string getFlashName(std::string const& str) = 0;
 
+    /// get outline silhouette of an area of a texture. The silhouette is created once per
+    /// texture, area and width, so drawing an outline costs one draw call.
+    /// \param str texture identifier
+    /// \param rect area of the texture
+    /// \param width outline width in pixel
+    /// \return shared pointer to SDL_Texture, larger than rect by width pixel in every direction,
+    /// nullptr if the silhouette could not be created. A failed silhouette is not cached.
+    virtual std::shared_ptr<SDL_Texture> getOutline(
+        std::string const& str, jt::Recti const& rect, int width) = 0;
+
     /// get number of textures
     /// \return the number of textures
     virtual std::size_t getNumberOfTextures() noexcept = 0;
 
+    /// get the estimated memory of all loaded textures
+    /// \return memory usage in bytes
+    virtual std::size_t getMemoryUsage() const noexcept = 0;
+
+    /// get the estimated memory of a single texture
+    /// \param str texture identifier
+    /// \return memory usage in bytes, 0 if the texture is not loaded
+    virtual std::size_t getMemoryUsage(std::string const& str) const = 0;
+
+    /// set the memory budget for evictUnused()
+    /// \param bytes memory budget in bytes, 0 for no budget
+    virtual void setMemoryBudget(std::size_t bytes) noexcept = 0;
+
+    /// remove least recently used textures, which are not used by any drawable, until the memory
+    /// usage is within the budget. Prefetched textures which were not requested by get() yet
+    /// survive a limited number of calls, so preloaded textures are kept while loading but do not
+    /// exceed the budget forever.
+    /// Evicted textures are loaded again on the next get().
+    virtual void evictUnused() = 0;
+
+    /// set a palette swap for textures with the ".palette=<name>" postfix, e.g.
+    /// "assets/player.aseprite.palette=enemy". All swaps of an image share one buffer of palette
+    /// indices. Textures already created for this swap are updated in place, so drawables using
+    /// them change their colors without creating new textures.
+    /// \param name name of the palette swap
+    /// \param source colors to replace
+    /// \param target replacement for the color with the same index in source
+    virtual void setPaletteSwap(
+        std::string const& name, jt::Palette const& source, jt::Palette const& target)
+        = 0;
+
     virtual ~TextureManagerInterface() = default;
 };
 } // namespace jt
@@ -0,0 +1,168 @@
+#include "tiled_sprite.hpp"
+#include <math_helper.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float wrapToTexture(float value, float textureSize)
+{
+    auto const wrapped = std::fmod(std::floor(value), textureSize);
+    return wrapped < 0.0f ? wrapped + textureSize : wrapped;
+}
+
+} // namespace
+
+namespace jt {
+
+TiledSprite::TiledSprite(std::string const& fileName, jt::Vector2f const& size,
+    jt::TextureManagerInterface& textureManager)
+    : m_fileName { fileName }
+    , m_textureManager { &textureManager }
+    , m_size { size }
+{
+    m_text = textureManager.get(fileName);
+    int w { 0 };
+    int h { 0 };
+    SDL_QueryTexture(m_text.get(), nullptr, nullptr, &w, &h);
+    m_textureSize = jt::Vector2f { static_cast<float>(w), static_cast<float>(h) };
+}
+
+void TiledSprite::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
+
+jt::Vector2f TiledSprite::getPosition() const { return m_position; }
+
+void TiledSprite::setColor(jt::Color const& col) { m_color = col; }
+
+jt::Color TiledSprite::getColor() const { return m_color; }
+
+jt::Rectf TiledSprite::getGlobalBounds() const
+{
+    // screen position like Sprite, which includes offset, shake and camera
+    refreshTransform();
+    return jt::Rectf { m_screenPosition.x, m_screenPosition.y, m_size.x, m_size.y };
+}
+
+jt::Rectf TiledSprite::getLocalBounds() const
+{
+    return jt::Rectf { 0.0f, 0.0f, m_size.x, m_size.y };
+}
+
+void TiledSprite::setScale(jt::Vector2f const& scale) { m_scale = scale; }
+
+jt::Vector2f TiledSprite::getScale() const { return m_scale; }
+
+void TiledSprite::setSize(jt::Vector2f const& size) { m_size = size; }
+
+jt::Vector2f TiledSprite::getSize() const { return m_size; }
+
+void TiledSprite::setScrollOffset(jt::Vector2f const& offset) { m_scrollOffset = offset; }
+
+jt::Vector2f TiledSprite::getScrollOffset() const { return m_scrollOffset; }
+
+jt::Vector2f TiledSprite::getTextureSize() const { return m_textureSize; }
+
+void TiledSprite::doUpdate(float /*elapsed*/) noexcept { }
+
+void TiledSprite::doRefreshTransform() const
+{
+    m_screenPosition = jt::MathHelper::castToInteger(
+        m_position + getShakeOffset() + getOffset() + getCamOffset());
+}
+
+void TiledSprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    drawTiles(sptr, m_text.get(), getShadowOffset(), getShadowColor());
+}
+
+void TiledSprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    for (auto const& outlineOffset : getOutlineOffsets()) {
+        drawTiles(sptr, m_text.get(), outlineOffset, getOutlineColor());
+    }
+}
+
+void TiledSprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    drawTiles(sptr, m_text.get(), jt::Vector2f { 0.0f, 0.0f }, m_color);
+}
+
+void TiledSprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!m_textFlash) {
+        m_textFlash = m_textureManager->get(m_textureManager->getFlashName(m_fileName));
+    }
+    drawTiles(sptr, m_textFlash.get(), jt::Vector2f { 0.0f, 0.0f }, getFlashColor());
+}
+
+void TiledSprite::doRotate(float /*rot*/) noexcept { }
+
+void TiledSprite::drawTiles(std::shared_ptr<jt::RenderTargetLayer> const& sptr,
+    SDL_Texture* texture, jt::Vector2f const& positionOffset, jt::Color const& col) const
+{
+    if (!sptr || !texture) [[unlikely]] {
+        return;
+    }
+    auto const scale = jt::Vector2f { std::fabs(m_scale.x), std::fabs(m_scale.y) };
+    if (m_textureSize.x <= 0.0f || m_textureSize.y <= 0.0f || scale.x == 0.0f
+        || scale.y == 0.0f) [[unlikely]] {
+        return;
+    }
+
+    // SDL clamps texture coordinates, so the region is split into one quad per (partial) tile.
+    // All quads are drawn with a single SDL_RenderGeometry call.
+    m_vertices.clear();
+    m_indices.clear();
+    auto const origin = m_screenPosition + positionOffset;
+    SDL_Color const vertexColor { col.r, col.g, col.b, col.a };
+    auto const regionSize = jt::Vector2f { m_size.x / scale.x, m_size.y / scale.y };
+    auto const start = jt::Vector2f { wrapToTexture(m_scrollOffset.x, m_textureSize.x),
+        wrapToTexture(m_scrollOffset.y, m_textureSize.y) };
+
+    auto addQuad = [&](float x, float y, float u, float v, float w, float h) {
+        auto const first = static_cast<int>(m_vertices.size());
+        auto const left = origin.x + x * scale.x;
+        auto const top = origin.y + y * scale.y;
+        auto const right = left + w * scale.x;
+        auto const bottom = top + h * scale.y;
+        auto const u0 = u / m_textureSize.x;
+        auto const v0 = v / m_textureSize.y;
+        auto const u1 = (u + w) / m_textureSize.x;
+        auto const v1 = (v + h) / m_textureSize.y;
+        m_vertices.push_back(SDL_Vertex { SDL_FPoint { left, top }, vertexColor, { u0, v0 } });
+        m_vertices.push_back(SDL_Vertex { SDL_FPoint { right, top }, vertexColor, { u1, v0 } });
+        m_vertices.push_back(SDL_Vertex { SDL_FPoint { right, bottom }, vertexColor, { u1, v1 } });
+        m_vertices.push_back(SDL_Vertex { SDL_FPoint { left, bottom }, vertexColor, { u0, v1 } });
+        for (auto const index : { 0, 1, 2, 0, 2, 3 }) {
+            m_indices.push_back(first + index);
+        }
+    };
+
+    auto v = start.y;
+    for (auto y = 0.0f; y < regionSize.y;) {
+        auto const h = std::min(m_textureSize.y - v, regionSize.y - y);
+        auto u = start.x;
+        for (auto x = 0.0f; x < regionSize.x;) {
+            auto const w = std::min(m_textureSize.x - u, regionSize.x - x);
+            addQuad(x, y, u, v, w, h);
+            x += w;
+            u = 0.0f;
+        }
+        y += h;
+        v = 0.0f;
+    }
+
+    // the texture is shared with other drawables, so its blend mode is only changed for this call
+    SDL_BlendMode previousBlendMode { SDL_BLENDMODE_BLEND };
+    SDL_GetTextureBlendMode(texture, &previousBlendMode);
+    SDL_SetTextureBlendMode(texture, getSDLBlendMode());
+    SDL_RenderGeometry(sptr.get(), texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+        m_indices.data(), static_cast<int>(m_indices.size()));
+    SDL_SetTextureBlendMode(texture, previousBlendMode);
+}
+
+} // namespace jt
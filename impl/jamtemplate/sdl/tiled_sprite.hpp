@@ -0,0 +1,100 @@
+#ifndef JAMTEMPLATE_TILED_SPRITE_HPP
+#define JAMTEMPLATE_TILED_SPRITE_HPP
+
+#include <color/color.hpp>
+#include <drawable_impl_sdl.hpp>
+#include <render_target_layer.hpp>
+#include <sdl_2_include.hpp>
+#include <texture_manager_interface.hpp>
+#include <vector.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Drawable that fills a rectangular region with a repeating texture in one draw call, e.g. for
+/// parallax backgrounds. Rotation is not supported.
+class TiledSprite : public DrawableImplSdl {
+public:
+    using Sptr = std::shared_ptr<TiledSprite>;
+
+    /// Constructor
+    /// \param fileName texture to repeat
+    /// \param size size of the region in pixel
+    /// \param textureManager texture manager
+    TiledSprite(std::string const& fileName, jt::Vector2f const& size,
+        jt::TextureManagerInterface& textureManager);
+
+    void setPosition(jt::Vector2f const& pos) override;
+    jt::Vector2f getPosition() const override;
+
+    void setColor(jt::Color const& col) override;
+    jt::Color getColor() const override;
+
+    jt::Rectf getGlobalBounds() const override;
+    jt::Rectf getLocalBounds() const override;
+
+    /// Set the scale of the texture. The size of the region is not affected.
+    /// \param scale the scale, negative values are treated as positive
+    void setScale(jt::Vector2f const& scale) override;
+    jt::Vector2f getScale() const override;
+
+    /// Set the size of the region
+    /// \param size size in pixel
+    void setSize(jt::Vector2f const& size);
+
+    /// Get the size of the region
+    /// \return size in pixel
+    jt::Vector2f getSize() const;
+
+    /// Set the scroll offset, i.e. the texture coordinate shown in the top left corner of the
+    /// region. Values outside of the texture size wrap around.
+    /// \param offset the offset in texture pixel
+    void setScrollOffset(jt::Vector2f const& offset);
+
+    /// Get the scroll offset
+    /// \return offset in texture pixel
+    jt::Vector2f getScrollOffset() const;
+
+    /// Get the size of the repeated texture
+    /// \return size in texture pixel
+    jt::Vector2f getTextureSize() const;
+
+private:
+    std::shared_ptr<SDL_Texture> m_text { nullptr };
+    std::string m_fileName { "" };
+
+    // flash texture is requested from the texture manager when it is drawn first
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    mutable std::shared_ptr<SDL_Texture> m_textFlash { nullptr };
+
+    jt::Vector2f m_position { 0.0f, 0.0f };
+    jt::Vector2f m_size { 0.0f, 0.0f };
+    jt::Vector2f m_scrollOffset { 0.0f, 0.0f };
+    jt::Vector2f m_textureSize { 0.0f, 0.0f };
+    jt::Color m_color { jt::colors::White };
+
+    // backend transform, calculated in doRefreshTransform()
+    mutable jt::Vector2f m_screenPosition { 0.0f, 0.0f };
+
+    // scratch buffers for the geometry, reused to avoid allocations per frame
+    mutable std::vector<SDL_Vertex> m_vertices {};
+    mutable std::vector<int> m_indices {};
+
+    void doUpdate(float /*elapsed*/) noexcept override;
+    void doRefreshTransform() const override;
+
+    void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doRotate(float /*rot*/) noexcept override;
+
+    void drawTiles(std::shared_ptr<jt::RenderTargetLayer> const& sptr, SDL_Texture* texture,
+        jt::Vector2f const& positionOffset, jt::Color const& col) const;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_TILED_SPRITE_HPP
@@ -0,0 +1,12 @@
+#include "font_lib.hpp"
+#include <iostream>
+
+std::shared_ptr<jt::FontLib> jt::loadFontLib(std::string const& fontFileName,
+    unsigned int /*characterSize*/, std::shared_ptr<jt::RenderTargetLayer> /*renderTarget*/)
+{
+    auto font = std::make_shared<sf::Font>();
+    if (!font->loadFromFile(fontFileName)) {
+        std::cerr << "cannot load font: " << fontFileName << std::endl;
+    }
+    return font;
+}
@@ -0,0 +1,23 @@
+#ifndef JAMTEMPLATE_FONT_LIB_HPP
+#define JAMTEMPLATE_FONT_LIB_HPP
+
+#include <SFML/Graphics.hpp>
+#include <render_target_layer.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+using FontLib = sf::Font;
+
+/// Open a font
+/// \param fontFileName path to the font (ttf)
+/// \param characterSize character size (unused for sfml, sf::Font handles all sizes)
+/// \param renderTarget the render target (unused for sfml, but needed for sdl compatibility)
+/// \return the font
+std::shared_ptr<jt::FontLib> loadFontLib(std::string const& fontFileName,
+    unsigned int characterSize, std::shared_ptr<jt::RenderTargetLayer> renderTarget);
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_FONT_LIB_HPP
@@ -5,16 +5,12 @@
 #include <sprite.hpp>
 #include <tracy/Tracy.hpp>
 #include <vector_lib.hpp>
+#include <stdexcept>
+#include <string>
 
 namespace {
-
-void horizontalFlip(std::unique_ptr<jt::Sprite> const& spr, float zoom, float window_size_y)
-{
-    spr->setScale(jt::Vector2f { zoom, -zoom });
-    spr->setPosition({ spr->getPosition().x, spr->getPosition().y + window_size_y });
-    spr->update(0.0f);
-}
-
+// time per frame spent on uploading prefetched textures, so loading does not cause hitches
+constexpr float textureUploadBudget { 0.002f };
 } // namespace
 
 jt::GfxImpl::GfxImpl(RenderWindowInterface& window, CamInterface& cam)
@@ -32,6 +28,18 @@ jt::GfxImpl::GfxImpl(RenderWindowInterface& window, CamInterface& cam)
         jt::Rectf { 0, 0, static_cast<float>(scaledWidth), static_cast<float>(scaledHeight) }));
     m_view->setViewport(toLib(jt::Rectf { 0, 0, 1, 1 }));
     m_viewHalfSize = fromLib(m_view->getSize() * 0.5f);
+
+    m_renderQueue = std::make_shared<jt::RenderQueue>();
+    DrawableImpl::setRenderQueue(m_renderQueue);
+    DrawableImpl::setStaticRenderTarget(m_target);
+    DrawableImpl::setStaticViewSize(fromLib(m_view->getSize()));
+}
+
+jt::GfxImpl::~GfxImpl()
+{
+    DrawableImpl::setRenderQueue(nullptr);
+    DrawableImpl::setStaticRenderTarget({});
+    DrawableImpl::setStaticViewSize(jt::Vector2f { 0.0f, 0.0f });
 }
 
 jt::RenderWindowInterface& jt::GfxImpl::window() { return m_window; }
@@ -53,36 +61,46 @@ void jt::GfxImpl::update(float elapsed)
     m_view->setCenter(
         toLib(jt::MathHelper::castToInteger(m_camera.getCamOffset() + m_viewHalfSize)));
 
-    DrawableImpl::setCamOffset(m_viewHalfSize - fromLib(m_view->getCenter()));
+    auto const camOffset = m_viewHalfSize - fromLib(m_view->getCenter());
+    if (camOffset != DrawableImpl::getStaticCamOffset()) {
+        // cached layers show the world at the old camera position
+        m_target->invalidateCamLayers();
+    }
+    DrawableImpl::setCamOffset(camOffset);
+
+    m_textureManager->uploadPrefetched(textureUploadBudget);
+    m_textureManager->evictUnused();
 }
 
 void jt::GfxImpl::clear() { m_target->clearPixels(); }
 
 void jt::GfxImpl::display()
 {
-    m_target->forall([this](auto& layer) { drawOneZLayer(layer); });
-    m_window.display();
-}
-
-void jt::GfxImpl::drawOneZLayer(std::shared_ptr<jt::RenderTargetLayer> const& layer)
-{
-    if (layer == nullptr) [[unlikely]] {
-        throw std::invalid_argument {
-            "GfXImpl::display called with nullptr jt::RenderTargetLayer"
-        };
+    m_renderQueue->flush();
+
+    auto const position = getLayerSpritePosition();
+    bool first { true };
+    for (auto& kvp : m_layerSprites) {
+        // Layers without draws this frame are fully transparent, unless they are cached. The
+        // lowest layer is always drawn, as it provides the opaque background.
+        if (first || m_target->hasContent(kvp.first)) {
+            if (kvp.second->getPosition() != position) {
+                kvp.second->setPosition(position);
+                kvp.second->update(0.0f);
+            }
+            m_window.draw(kvp.second);
+        }
+        first = false;
     }
-    // convert renderTarget to sprite and draw that
-    auto spriteForDrawing = std::make_unique<jt::Sprite>();
-    spriteForDrawing->fromTexture(layer->getTexture());
-    auto const shakeOffset = m_camera.getShakeOffset();
-    spriteForDrawing->setPosition(shakeOffset);
-    // Note: RenderTexture has a bug and is displayed upside down
-    horizontalFlip(spriteForDrawing, m_camera.getZoom(), m_window.getSize().y);
-    m_window.draw(spriteForDrawing);
+    m_window.display();
 }
 
 void jt::GfxImpl::createZLayer(int z)
 {
+    if (m_target->contains(z)) {
+        // keep the existing target, e.g. when a state creates its layers again
+        return;
+    }
     auto const target = m_window.createRenderTarget();
 
     auto const scaledWidth = static_cast<unsigned int>(m_window.getSize().x / m_camera.getZoom());
@@ -92,4 +110,28 @@ void jt::GfxImpl::createZLayer(int z)
     target->setSmooth(false);
 
     m_target->add(z, target);
+
+    auto layerSprite = std::make_unique<jt::Sprite>();
+    layerSprite->fromTexture(target->getTexture());
+    // Note: RenderTexture has a bug and is displayed upside down
+    layerSprite->setScale(jt::Vector2f { m_camera.getZoom(), -m_camera.getZoom() });
+    layerSprite->setPosition(getLayerSpritePosition());
+    layerSprite->update(0.0f);
+    m_layerSprites[z] = std::move(layerSprite);
+}
+
+jt::Vector2f jt::GfxImpl::getLayerSpritePosition() const
+{
+    // layer sprites are flipped vertically, so they need to be moved down by the window height
+    return m_camera.getShakeOffset() + jt::Vector2f { 0.0f, m_window.getSize().y };
+}
+
+void jt::GfxImpl::setZLayerSorted(int z, bool sorted)
+{
+    auto const layer = m_target->find(z);
+    if (!layer) {
+        throw std::invalid_argument { "setZLayerSorted called for z layer " + std::to_string(z)
+            + " which was not created" };
+    }
+    m_renderQueue->setTargetSorted(layer.get(), sorted);
 }
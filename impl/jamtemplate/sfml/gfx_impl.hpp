@@ -3,9 +3,13 @@
 
 #include <camera.hpp>
 #include <graphics/gfx_interface.hpp>
+#include <graphics/render_queue.hpp>
 #include <graphics/render_window.hpp>
 #include <render_target_lib.hpp>
+#include <sprite.hpp>
 #include <texture_manager_impl.hpp>
+#include <map>
+#include <memory>
 #include <optional>
 
 namespace jt {
@@ -13,6 +17,8 @@ namespace jt {
 class GfxImpl : public GfxInterface {
 public:
     GfxImpl(RenderWindowInterface& window, CamInterface& cam);
+    ~GfxImpl() override;
+
     RenderWindowInterface& window() override;
     CamInterface& camera() override;
 
@@ -25,6 +31,7 @@ public:
     void display() override;
 
     void createZLayer(int z) override;
+    void setZLayerSorted(int z, bool sorted) override;
 
 private:
     RenderWindowInterface& m_window;
@@ -33,8 +40,11 @@ private:
     std::shared_ptr<jt::RenderTarget> m_target { nullptr };
     std::optional<jt::TextureManagerImpl> m_textureManager {};
     std::shared_ptr<sf::View> m_view { nullptr };
+    std::shared_ptr<jt::RenderQueue> m_renderQueue { nullptr };
+    // one persistent sprite per z layer to draw the layer texture to the window
+    std::map<int, std::unique_ptr<jt::Sprite>> m_layerSprites {};
 
-    void drawOneZLayer(std::shared_ptr<jt::RenderTargetLayer> const& layer);
+    jt::Vector2f getLayerSpritePosition() const;
 };
 
 } // namespace jt
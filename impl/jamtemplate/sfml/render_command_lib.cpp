@@ -0,0 +1,44 @@
+#include "render_command_lib.hpp"
+
+namespace {
+
+std::uint64_t getBlendModeKey(sf::BlendMode const& mode) noexcept
+{
+    if (mode == sf::BlendAlpha) {
+        return 0u;
+    }
+    if (mode == sf::BlendAdd) {
+        return 1u;
+    }
+    if (mode == sf::BlendMultiply) {
+        return 2u;
+    }
+    return 3u;
+}
+
+} // namespace
+
+void const* jt::RenderCommand::getTarget() const noexcept { return target; }
+
+std::uint64_t jt::RenderCommand::getStateKey() const noexcept
+{
+    auto const* const texture = sprite.getTexture();
+    std::uint64_t const textureKey = texture ? (texture->getNativeHandle() & 0xFFFFFFFFFFu) : 0u;
+    return (getBlendModeKey(blendMode) << 40u) | textureKey;
+}
+
+void jt::RenderCommand::draw() const
+{
+    if (!target) [[unlikely]] {
+        return;
+    }
+    target->draw(sprite, sf::RenderStates { blendMode });
+}
+
+void jt::submitRenderCommands(
+    std::vector<RenderCommand> const& commands, std::vector<std::uint32_t> const& order)
+{
+    for (auto const idx : order) {
+        commands[idx].draw();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
+#define JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
+
+#include <SFML/Graphics.hpp>
+#include <render_target_layer.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace jt {
+
+/// One sprite to be drawn into a ZLayer.
+struct RenderCommand {
+    /// layer the command is drawn into
+    jt::RenderTargetLayer* target { nullptr };
+    sf::Sprite sprite {};
+    sf::BlendMode blendMode { sf::BlendAlpha };
+    /// keeps the texture of the sprite alive until the command is drawn, even if the drawable or
+    /// the texture manager release it in the meantime
+    std::shared_ptr<sf::Texture const> texture { nullptr };
+
+    /// Get the target the command is drawn into
+    /// \return the target
+    void const* getTarget() const noexcept;
+
+    /// Get the render state (texture and blend mode) packed into the lower 48 bit
+    /// \return the state key
+    std::uint64_t getStateKey() const noexcept;
+
+    /// Draw the command into its target
+    void draw() const;
+};
+
+/// Draw render commands in the given order.
+/// \param commands the commands
+/// \param order indices into commands
+void submitRenderCommands(
+    std::vector<RenderCommand> const& commands, std::vector<std::uint32_t> const& order);
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_RENDER_COMMAND_LIB_HPP
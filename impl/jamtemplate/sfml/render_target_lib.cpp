@@ -8,18 +8,67 @@ void jt::RenderTarget::forall(
     }
 }
 
-std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z) { return m_targets[z]; }
+std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z)
+{
+    m_layerStates.touch(z);
+    return m_targets[z];
+}
+
+bool jt::RenderTarget::needsRedraw(int z) const { return m_layerStates.needsRedraw(z); }
+
+void jt::RenderTarget::setLayerCached(int z, bool cached) { m_layerStates.setCached(z, cached); }
+
+bool jt::RenderTarget::isLayerCached(int z) const { return m_layerStates.isCached(z); }
+
+void jt::RenderTarget::setLayerIgnoresCamMovement(int z, bool ignore)
+{
+    m_layerStates.setIgnoresCamMovement(z, ignore);
+}
+
+void jt::RenderTarget::resetLayers() { m_layerStates.reset(); }
+
+void jt::RenderTarget::invalidateLayer(int z, jt::Rectf const& rect)
+{
+    if (!m_layerStates.isCached(z)) {
+        // uncached layers are redrawn every frame anyway
+        return;
+    }
+    auto const it = m_targets.find(z);
+    if (it == m_targets.cend() || !it->second) [[unlikely]] {
+        return;
+    }
+    auto const size = it->second->getSize();
+    m_layerStates.invalidate(
+        z, rect, jt::Vector2f { static_cast<float>(size.x), static_cast<float>(size.y) });
+}
+
+void jt::RenderTarget::invalidateCamLayers() { m_layerStates.invalidateCamLayers(); }
 
 void jt::RenderTarget::add(int z, std::shared_ptr<jt::RenderTargetLayer> target)
 {
     m_targets[z] = target;
+    m_layerStates.add(z);
 }
 
-void jt::RenderTarget::clearPixels() const
+bool jt::RenderTarget::contains(int z) const { return m_targets.contains(z); }
+
+std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::find(int z) const
+{
+    auto const it = m_targets.find(z);
+    return it == m_targets.cend() ? nullptr : it->second;
+}
+
+bool jt::RenderTarget::hasContent(int z) const { return m_layerStates.hasContent(z); }
+
+void jt::RenderTarget::clearPixels()
 {
     bool first { true };
 
     for (auto const& kvp : m_targets) {
+        if (!m_layerStates.beginFrame(kvp.first)) {
+            first = false;
+            continue;
+        }
         if (first) {
             kvp.second->clear(sf::Color::Black);
             first = false;
@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 #define JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 
+#include <graphics/layer_states.hpp>
 #include <graphics/render_target_interface.hpp>
 
 namespace jt {
@@ -8,13 +9,38 @@ namespace jt {
 class RenderTarget : public RenderTargetInterface {
 public:
     std::shared_ptr<jt::RenderTargetLayer> get(int z) override;
+    bool needsRedraw(int z) const override;
+    void setLayerCached(int z, bool cached) override;
+    bool isLayerCached(int z) const override;
+    void setLayerIgnoresCamMovement(int z, bool ignore) override;
+    void invalidateLayer(int z, jt::Rectf const& rect) override;
+    void resetLayers() override;
+
+    /// Invalidate all cached layers that depend on the camera, because the camera moved
+    void invalidateCamLayers();
 
     void forall(std::function<void(std::shared_ptr<jt::RenderTargetLayer>&)> const& func);
     void add(int z, std::shared_ptr<jt::RenderTargetLayer> target);
-    void clearPixels() const;
+    void clearPixels();
+
+    /// Check if a layer was added for z
+    /// \param z the z layer
+    /// \return true if the layer exists, false otherwise
+    bool contains(int z) const;
+
+    /// Get the layer for z without marking it as drawn to
+    /// \param z the z layer
+    /// \return the layer, nullptr if no layer was added for z
+    std::shared_ptr<jt::RenderTargetLayer> find(int z) const;
+
+    /// Check if a layer can contain pixels in this frame
+    /// \param z the z layer
+    /// \return true if the layer needs to be composited, false otherwise
+    bool hasContent(int z) const;
 
 private:
     std::map<int, std::shared_ptr<jt::RenderTargetLayer>> m_targets;
+    jt::LayerStates m_layerStates;
 };
 
 } // namespace jt
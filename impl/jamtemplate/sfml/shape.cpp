@@ -8,19 +8,25 @@ void jt::Shape::makeRect(jt::Vector2f size, jt::TextureManagerInterface& /*unuse
 {
     m_shape = std::make_shared<sf::RectangleShape>(toLib(size));
     m_flashShape = std::make_shared<sf::RectangleShape>(toLib(size));
+    markTransformDirty();
 }
 
 void jt::Shape::makeCircle(float radius, jt::TextureManagerInterface& /*unused*/)
 {
     m_shape = std::make_shared<sf::CircleShape>(radius);
     m_flashShape = std::make_shared<sf::CircleShape>(radius);
+    markTransformDirty();
 }
 
 void jt::Shape::setColor(jt::Color const& col) { m_shape->setFillColor(toLib(col)); }
 
 jt::Color jt::Shape::getColor() const { return fromLib(m_shape->getFillColor()); }
 
-void jt::Shape::setPosition(jt::Vector2f const& pos) { m_position = pos; }
+void jt::Shape::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
 
 jt::Vector2f jt::Shape::getPosition() const { return m_position; }
 
@@ -29,6 +35,7 @@ jt::Rectf jt::Shape::getGlobalBounds() const
     if (!m_shape) [[unlikely]] {
         return jt::Rectf { 0.0f, 0.0f, 0.0f, 0.0f };
     }
+    refreshTransform();
     return fromLib(m_shape->getGlobalBounds());
 }
 
@@ -70,12 +77,20 @@ void jt::Shape::doUpdate(float /*elapsed*/)
         return;
     }
 
+    m_flashShape->setFillColor(toLib(getFlashColor()));
+}
+
+void jt::Shape::doRefreshTransform() const
+{
+    if (!m_shape) [[unlikely]] {
+        return;
+    }
+
     auto const floatPos = getPosition() + getShakeOffset() + getOffset() + getCompleteCamOffset();
 
     auto const screenPosition = jt::MathHelper::castToInteger(floatPos);
     m_shape->setPosition(screenPosition.x, screenPosition.y);
     m_flashShape->setPosition(screenPosition.x, screenPosition.y);
-    m_flashShape->setFillColor(toLib(getFlashColor()));
 }
 
 void jt::Shape::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -146,6 +161,68 @@ void jt::Shape::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) c
     sptr->draw(*m_flashShape);
 }
 
+void jt::Shape::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
+{
+    if (!m_shape) [[unlikely]] {
+        return;
+    }
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    sf::RenderStates const states { getSfBlendMode() };
+    auto const oldPosition = m_shape->getPosition();
+    auto const offset = getShakeOffset() + getOffset() + getCompleteCamOffset();
+    for (auto const& position : positions) {
+        m_shape->setPosition(toLib(jt::MathHelper::castToInteger(position + offset)));
+        sptr->draw(*m_shape, states);
+    }
+    m_shape->setPosition(oldPosition);
+}
+
+void jt::Shape::doDrawTransformedInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::DrawInstance const> instances) const
+{
+    if (!m_shape) [[unlikely]] {
+        return;
+    }
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+    auto const pointCount = m_shape->getPointCount();
+    if (pointCount < 3) [[unlikely]] {
+        return;
+    }
+
+    auto const offset = getShakeOffset() + getOffset() + getCompleteCamOffset();
+    auto const origin = m_shape->getOrigin();
+    m_instanceVertices.clear();
+    m_instanceVertices.reserve(instances.size() * (pointCount - 2u) * 3u);
+    for (auto const& instance : instances) {
+        // same transformation as sf::Transformable
+        sf::Transform transform {};
+        transform.translate(toLib(jt::MathHelper::castToInteger(instance.position + offset)));
+        transform.rotate(instance.rotation);
+        transform.scale(instance.scale.x, instance.scale.y);
+        transform.translate(-origin);
+
+        auto const color = toLib(instance.color);
+        // shapes are convex, so a triangle fan around the first point covers the whole shape
+        auto const first = transform.transformPoint(m_shape->getPoint(0u));
+        for (std::size_t i = 1u; i + 1u < pointCount; ++i) {
+            m_instanceVertices.emplace_back(first, color);
+            m_instanceVertices.emplace_back(transform.transformPoint(m_shape->getPoint(i)), color);
+            m_instanceVertices.emplace_back(
+                transform.transformPoint(m_shape->getPoint(i + 1u)), color);
+        }
+    }
+
+    // all instances are drawn with a single draw call
+    sf::RenderStates const states { getSfBlendMode() };
+    sptr->draw(m_instanceVertices.data(), m_instanceVertices.size(), sf::Triangles, states);
+}
+
 void jt::Shape::doRotate(float rot)
 {
     if (!m_shape) [[unlikely]] {
@@ -6,6 +6,7 @@
 #include <render_target_layer.hpp>
 #include <texture_manager_interface.hpp>
 #include <memory>
+#include <vector>
 
 namespace sf {
 class Shape;
@@ -46,12 +47,20 @@ private:
 
     jt::Vector2f m_position { 0, 0 };
 
+    // triangles of all instances, reused between frames
+    mutable std::vector<sf::Vertex> m_instanceVertices {};
+
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const override;
+    void doDrawTransformedInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::DrawInstance const> instances) const override;
 
     void doUpdate(float elapsed) override;
+    void doRefreshTransform() const override;
     void doRotate(float rot) override;
 };
 } // namespace jt
@@ -7,22 +7,60 @@
 jt::Sprite::Sprite() { }
 
 jt::Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager)
-    : m_sprite { sf::Sprite { textureManager.get(fileName) } }
-    , m_flashSprite { sf::Sprite { textureManager.get(textureManager.getFlashName(fileName)) } }
+    : m_texture { textureManager.get(fileName) }
+    , m_sprite { sf::Sprite { *m_texture } }
+    , m_fileName { fileName }
+    , m_textureManager { &textureManager }
 {
 }
 
 jt::Sprite::Sprite(
     std::string const& fileName, jt::Recti const& rect, jt::TextureManagerInterface& textureManager)
-    : m_sprite { sf::Sprite { textureManager.get(fileName), toLib(rect) } }
-    , m_flashSprite { sf::Sprite {
-          textureManager.get(textureManager.getFlashName(fileName)), toLib(rect) } }
+    : m_texture { textureManager.get(fileName) }
+    , m_sprite { sf::Sprite { *m_texture, toLib(rect) } }
+    , m_fileName { fileName }
+    , m_textureManager { &textureManager }
 {
 }
 
-void jt::Sprite::fromTexture(sf::Texture const& text) { m_sprite.setTexture(text); }
+jt::Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager,
+    jt::LoadAsyncTag)
+    : m_texture { textureManager.getAsync(fileName) }
+    , m_sprite { sf::Sprite { *m_texture, sf::IntRect { 0, 0, 0, 0 } } }
+    , m_fileName { fileName }
+    , m_textureManager { &textureManager }
+    , m_textureLoading { true }
+{
+    takeLoadedTexture();
+}
 
-void jt::Sprite::setPosition(jt::Vector2f const& pos) { m_position = pos; }
+jt::Sprite::Sprite(std::string const& fileName, jt::Recti const& rect,
+    jt::TextureManagerInterface& textureManager, jt::LoadAsyncTag)
+    : m_texture { textureManager.getAsync(fileName) }
+    , m_sprite { sf::Sprite { *m_texture, toLib(rect) } }
+    , m_fileName { fileName }
+    , m_textureManager { &textureManager }
+    , m_textureLoading { true }
+    , m_useWholeTexture { false }
+{
+    takeLoadedTexture();
+}
+
+void jt::Sprite::fromTexture(sf::Texture const& text)
+{
+    m_sprite.setTexture(text);
+    m_texture = nullptr;
+    m_fileName = "";
+    m_textureManager = nullptr;
+    m_textureLoading = false;
+    m_outlineSpriteWidth = 0;
+}
+
+void jt::Sprite::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
 
 jt::Vector2f jt::Sprite::getPosition() const { return m_position; }
 
@@ -30,7 +68,11 @@ void jt::Sprite::setColor(jt::Color const& col) { m_sprite.setColor(toLib(col));
 
 jt::Color jt::Sprite::getColor() const { return fromLib(m_sprite.getColor()); }
 
-jt::Rectf jt::Sprite::getGlobalBounds() const { return fromLib(m_sprite.getGlobalBounds()); }
+jt::Rectf jt::Sprite::getGlobalBounds() const
+{
+    refreshTransform();
+    return fromLib(m_sprite.getGlobalBounds());
+}
 
 jt::Rectf jt::Sprite::getLocalBounds() const { return fromLib(m_sprite.getLocalBounds()); }
 
@@ -64,7 +106,40 @@ void jt::Sprite::cleanImage() noexcept
     m_image = sf::Image {};
 }
 
-void jt::Sprite::doUpdate(float /*elapsed*/)
+void jt::Sprite::setTextureRect(jt::Recti const& rect)
+{
+    m_useWholeTexture = false;
+    auto const libRect = toLib(rect);
+    if (m_sprite.getTextureRect() == libRect) [[likely]] {
+        return;
+    }
+    m_sprite.setTextureRect(libRect);
+    if (m_flashSprite.getTexture()) {
+        m_flashSprite.setTextureRect(libRect);
+    }
+    // silhouettes are created per area of the texture
+    m_outlineSpriteWidth = 0;
+    markTransformDirty();
+    markContentChanged();
+}
+
+jt::Recti jt::Sprite::getTextureRect() const { return fromLib(m_sprite.getTextureRect()); }
+
+void jt::Sprite::doUpdate(float /*elapsed*/) { takeLoadedTexture(); }
+
+void jt::Sprite::takeLoadedTexture()
+{
+    if (!m_textureLoading || !m_textureManager->isLoaded(m_fileName)) [[likely]] {
+        return;
+    }
+    m_textureLoading = false;
+    m_texture = m_textureManager->get(m_fileName);
+    m_sprite.setTexture(*m_texture, m_useWholeTexture);
+    markTransformDirty();
+    markContentChanged();
+}
+
+void jt::Sprite::doRefreshTransform() const
 {
     m_lastScreenPosition = toLib(jt::MathHelper::castToInteger(
         getPosition() + getShakeOffset() + getOffset() + getCompleteCamOffset()));
@@ -76,37 +151,54 @@ void jt::Sprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr)
     if (!sptr) [[unlikely]] {
         return;
     }
-    jt::Vector2f const oldPos = fromLib(m_sprite.getPosition());
-    auto const oldCol = fromLib(m_sprite.getColor());
-
-    m_sprite.setPosition(toLib(jt::MathHelper::castToInteger(oldPos + getShadowOffset())));
-    m_sprite.setColor(toLib(getShadowColor()));
-    sptr->draw(m_sprite);
 
-    m_sprite.setPosition(toLib(oldPos));
-    m_sprite.setColor(toLib(oldCol));
+    jt::RenderCommand command { sptr.get(), m_sprite, sf::BlendAlpha, m_texture };
+    command.sprite.setPosition(toLib(
+        jt::MathHelper::castToInteger(fromLib(m_sprite.getPosition()) + getShadowOffset())));
+    command.sprite.setColor(toLib(getShadowColor()));
+    submit(command);
 }
 
 void jt::Sprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
+    // the silhouette would be created from the texture, which is not available yet
+    if (!sptr || m_textureLoading) [[unlikely]] {
         return;
     }
 
-    jt::Vector2f const oldPos = fromLib(m_sprite.getPosition());
-    jt::Color const oldCol = fromLib(m_sprite.getColor());
-
     auto col = getOutlineColor();
-    col.a = oldCol.a;
-    m_sprite.setColor(toLib(col));
+    col.a = m_sprite.getColor().a;
 
-    for (auto const outlineOffset : getOutlineOffsets()) {
-        m_sprite.setPosition(toLib(jt::MathHelper::castToInteger(oldPos + outlineOffset)));
-        sptr->draw(m_sprite);
+    auto const width = getOutlineWidth();
+    if (!m_textureManager || width <= 0) [[unlikely]] {
+        // no texture manager available (e.g. for sprites created from a texture): stamp the
+        // sprite at all outline offsets
+        jt::Vector2f const oldPos = fromLib(m_sprite.getPosition());
+        jt::RenderCommand command { sptr.get(), m_sprite, sf::BlendAlpha, m_texture };
+        command.sprite.setColor(toLib(col));
+        for (auto const outlineOffset : getOutlineOffsets()) {
+            command.sprite.setPosition(
+                toLib(jt::MathHelper::castToInteger(oldPos + outlineOffset)));
+            submit(command);
+        }
+        return;
     }
 
-    m_sprite.setPosition(toLib(oldPos));
-    m_sprite.setColor(toLib(oldCol));
+    if (m_outlineSpriteWidth != width) {
+        m_outlineTexture
+            = m_textureManager->getOutline(m_fileName, fromLib(m_sprite.getTextureRect()), width);
+        m_outlineSprite.setTexture(*m_outlineTexture, true);
+        m_outlineSpriteWidth = width;
+    }
+    // the silhouette is larger than the sprite by the outline width in every direction
+    auto const border = static_cast<float>(width);
+    m_outlineSprite.setOrigin(m_sprite.getOrigin() + sf::Vector2f { border, border });
+    m_outlineSprite.setPosition(m_sprite.getPosition());
+    m_outlineSprite.setScale(m_sprite.getScale());
+    m_outlineSprite.setRotation(m_sprite.getRotation());
+    m_outlineSprite.setColor(toLib(col));
+    submit(
+        jt::RenderCommand { sptr.get(), m_outlineSprite, sf::BlendAlpha, m_outlineTexture });
 }
 
 void jt::Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -115,19 +207,43 @@ void jt::Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
         return;
     }
 
-    sf::RenderStates const states { getSfBlendMode() };
-    sptr->draw(m_sprite, states);
+    submit(jt::RenderCommand { sptr.get(), m_sprite, getSfBlendMode(), m_texture });
 }
 
 void jt::Sprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
+    if (!sptr || m_textureLoading) [[unlikely]] {
         return;
     }
 
+    if (!m_flashSprite.getTexture()) {
+        if (!m_textureManager) [[unlikely]] {
+            return;
+        }
+        m_flashTexture = m_textureManager->get(m_textureManager->getFlashName(m_fileName));
+        m_flashSprite.setTexture(*m_flashTexture);
+        m_flashSprite.setTextureRect(m_sprite.getTextureRect());
+    }
     m_flashSprite.setPosition(m_lastScreenPosition);
     m_flashSprite.setColor(toLib(getFlashColor()));
-    sptr->draw(m_flashSprite);
+    // flash is drawn immediately, so it always ends up above the sprite, even in sorted ZLayers
+    submit(
+        jt::RenderCommand { sptr.get(), m_flashSprite, sf::BlendAlpha, m_flashTexture }, false);
+}
+
+void jt::Sprite::doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    std::span<jt::Vector2f const> positions) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    jt::RenderCommand command { sptr.get(), m_sprite, getSfBlendMode(), m_texture };
+    auto const offset = getShakeOffset() + getOffset() + getCompleteCamOffset();
+    for (auto const& position : positions) {
+        command.sprite.setPosition(toLib(jt::MathHelper::castToInteger(position + offset)));
+        submit(command);
+    }
 }
 
 void jt::Sprite::doRotate(float rot)
@@ -136,6 +252,8 @@ void jt::Sprite::doRotate(float rot)
     m_flashSprite.setRotation(rot);
 }
 
+bool jt::Sprite::usesRenderQueue() const { return true; }
+
 void jt::Sprite::setOriginInternal(jt::Vector2f const& origin)
 {
     m_sprite.setOrigin(origin.x, origin.y);
@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <color/color.hpp>
 #include <drawable_impl_sfml.hpp>
+#include <graphics/load_async.hpp>
 #include <render_target_layer.hpp>
 #include <texture_manager_interface.hpp>
 #include <memory>
@@ -21,12 +22,35 @@ public:
     Sprite(std::string const& fileName, jt::Recti const& rect,
         jt::TextureManagerInterface& textureManager);
 
+    /// Constructor that does not wait for the texture to be decoded. A transparent placeholder is
+    /// drawn until the texture is uploaded, the sprite picks it up in update(). Until then the
+    /// bounds of the sprite are empty.
+    /// \param fileName texture identifier
+    /// \param textureManager texture manager
+    Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager,
+        jt::LoadAsyncTag);
+
+    /// Constructor that does not wait for the texture to be decoded, see above
+    /// \param fileName texture identifier
+    /// \param rect area of the texture to draw
+    /// \param textureManager texture manager
+    Sprite(std::string const& fileName, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager, jt::LoadAsyncTag);
+
     // WARNING: This function is slow, because it needs to copy
     // graphics memory to ram first.
     jt::Color getColorAtPixel(jt::Vector2u pixelPos) const;
 
     void cleanImage() noexcept;
 
+    /// Set the area of the texture to draw, e.g. the current frame of an animation
+    /// \param rect area of the texture in pixel
+    void setTextureRect(jt::Recti const& rect);
+
+    /// Get the area of the texture to draw
+    /// \return area of the texture in pixel
+    jt::Recti getTextureRect() const;
+
     void setPosition(jt::Vector2f const& pos) override;
     jt::Vector2f getPosition() const override;
 
@@ -43,28 +67,53 @@ public:
     void fromTexture(sf::Texture const& text);
 
     // DO NOT CALL THIS FROM GAME CODE!
-    sf::Sprite getSFSprite() const { return m_sprite; }
+    sf::Sprite getSFSprite() const
+    {
+        refreshTransform();
+        return m_sprite;
+    }
 
     void setOriginInternal(jt::Vector2f const& origin) override;
 
 private:
+    // textures are shared with the texture manager, so they are not evicted while in use
+    std::shared_ptr<sf::Texture> m_texture { nullptr };
+    mutable std::shared_ptr<sf::Texture> m_flashTexture { nullptr };
+    mutable std::shared_ptr<sf::Texture> m_outlineTexture { nullptr };
+
     mutable sf::Sprite m_sprite;
+    // flash texture is requested from the texture manager when it is drawn first
     mutable sf::Sprite m_flashSprite;
+
+    std::string m_fileName { "" };
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    // placeholder is drawn until the texture manager uploaded the texture
+    bool m_textureLoading { false };
+    bool m_useWholeTexture { true };
+    // outline silhouette, requested from the texture manager when the outline is drawn first
+    mutable sf::Sprite m_outlineSprite;
+    mutable int m_outlineSpriteWidth { 0 };
     // optimization for getColorAtPixel
     mutable sf::Image m_image;
     mutable bool m_imageStored { false };
 
     jt::Vector2f m_position { 0.0f, 0.0f };
 
-    sf::Vector2f m_lastScreenPosition { 0.0f, 0.0f };
+    mutable sf::Vector2f m_lastScreenPosition { 0.0f, 0.0f };
 
     void doUpdate(float /*elapsed*/) override;
+    void takeLoadedTexture();
+    void doRefreshTransform() const override;
 
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawInstances(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+        std::span<jt::Vector2f const> positions) const override;
     void doRotate(float rot) override;
+
+    bool usesRenderQueue() const override;
 };
 
 } // namespace jt
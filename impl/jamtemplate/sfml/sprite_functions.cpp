@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <vector>
 
 sf::Image jt::SpriteFunctions::makeButtonImage(unsigned int w, unsigned int h)
 {
@@ -109,3 +110,85 @@ sf::Image jt::SpriteFunctions::makeRing(unsigned int w)
     }
     return img;
 }
+
+sf::Image jt::SpriteFunctions::makeStripImage(sf::Image const& start, sf::Image const& middle,
+    sf::Image const& end, unsigned int w, unsigned int h, bool horizontal)
+{
+    sf::Image img {};
+    img.create(w, h, toLib(jt::colors::Transparent));
+
+    auto const startSize = start.getSize();
+    auto const middleSize = middle.getSize();
+    auto const endSize = end.getSize();
+
+    // pieces are copied including their alpha values instead of being blended onto the image
+    if (horizontal) {
+        auto const rowHeight = std::max(1u, startSize.y);
+        auto const endX = w - std::min(w, endSize.x);
+        for (auto y = 0u; y < h; y += rowHeight) {
+            for (auto x = startSize.x; x < endX; x += std::max(1u, middleSize.x)) {
+                img.copy(middle, x, y);
+            }
+            img.copy(start, 0u, y);
+            img.copy(end, endX, y);
+        }
+    } else {
+        auto const columnWidth = std::max(1u, startSize.x);
+        auto const endY = h - std::min(h, endSize.y);
+        for (auto x = 0u; x < w; x += columnWidth) {
+            for (auto y = startSize.y; y < endY; y += std::max(1u, middleSize.y)) {
+                img.copy(middle, x, y);
+            }
+            img.copy(start, x, 0u);
+            img.copy(end, x, endY);
+        }
+    }
+    return img;
+}
+
+sf::Image jt::SpriteFunctions::makeOutlineImage(
+    sf::Image const& image, sf::IntRect const& sourceRect, int width)
+{
+    auto const w = sourceRect.width + 2 * width;
+    auto const h = sourceRect.height + 2 * width;
+    auto const imageW = static_cast<int>(image.getSize().x);
+    auto const imageH = static_cast<int>(image.getSize().y);
+
+    // square dilation is separable: dilate rows first, then columns
+    std::vector<bool> opaque(static_cast<std::size_t>(w * h), false);
+    for (auto y = 0; y != sourceRect.height; ++y) {
+        auto const sourceY = sourceRect.top + y;
+        for (auto x = 0; x != sourceRect.width; ++x) {
+            auto const sourceX = sourceRect.left + x;
+            if (sourceX < 0 || sourceY < 0 || sourceX >= imageW || sourceY >= imageH) {
+                continue;
+            }
+            auto const pixel = image.getPixel(
+                static_cast<unsigned int>(sourceX), static_cast<unsigned int>(sourceY));
+            if (pixel.a == 0) {
+                continue;
+            }
+            for (auto dx = 0; dx <= 2 * width; ++dx) {
+                opaque[static_cast<std::size_t>((y + width) * w + x + dx)] = true;
+            }
+        }
+    }
+
+    sf::Image img {};
+    img.create(static_cast<unsigned int>(w), static_cast<unsigned int>(h),
+        toLib(jt::colors::Transparent));
+    for (auto x = 0; x != w; ++x) {
+        auto dilatedUntil = -1;
+        for (auto y = 0; y != h; ++y) {
+            // an opaque row reaches width pixel up and down, so it is picked up width rows early
+            if (y + width < h && opaque[static_cast<std::size_t>((y + width) * w + x)]) {
+                dilatedUntil = y + 2 * width;
+            }
+            if (y <= dilatedUntil) {
+                img.setPixel(static_cast<unsigned int>(x), static_cast<unsigned int>(y),
+                    toLib(jt::colors::White));
+            }
+        }
+    }
+    return img;
+}
@@ -17,6 +17,27 @@ sf::Image makeBlankImage(unsigned int w, unsigned int h);
 
 sf::Image makeRing(unsigned int w);
 
+/// Compose a strip from a start, a repeated middle and an end piece.
+/// \param start piece at the left (horizontal) or top (vertical)
+/// \param middle piece repeated between start and end
+/// \param end piece at the right (horizontal) or bottom (vertical)
+/// \param w width of the strip
+/// \param h height of the strip
+/// \param horizontal if true, pieces are placed left to right and rows are repeated vertically,
+/// if false, pieces are placed top to bottom and columns are repeated horizontally
+/// \return the composed image
+sf::Image makeStripImage(sf::Image const& start, sf::Image const& middle, sf::Image const& end,
+    unsigned int w, unsigned int h, bool horizontal);
+
+/// Create the outline silhouette of an area of an image: every pixel that is at most width pixel
+/// (horizontally and vertically) away from a non-transparent pixel is opaque white.
+/// \param image the source image
+/// \param sourceRect area of the source image
+/// \param width outline width in pixel, the silhouette is larger than sourceRect by width pixel
+/// in every direction
+/// \return the silhouette image, to be tinted with the outline color
+sf::Image makeOutlineImage(sf::Image const& image, sf::IntRect const& sourceRect, int width);
+
 } // namespace SpriteFunctions
 
 } // namespace jt
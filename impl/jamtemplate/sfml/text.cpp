@@ -9,26 +9,31 @@ jt::Text::~Text()
 {
     m_text = nullptr;
     m_flashText = nullptr;
+    m_outlineText = nullptr;
     m_font = nullptr;
 }
 
 void jt::Text::loadFont(std::string const& fontFileName, unsigned int characterSize,
-    std::weak_ptr<jt::RenderTargetLayer> /*wptr*/)
+    std::weak_ptr<jt::RenderTargetLayer> wptr, jt::FontCacheInterface& fontCache)
 {
-    m_font = std::make_shared<sf::Font>();
-    if (!m_font->loadFromFile(fontFileName)) {
-        std::cerr << "cannot load font: " << fontFileName << std::endl;
-    }
+    m_font = fontCache.get(fontFileName, characterSize, wptr.lock());
     m_text = std::make_shared<sf::Text>("", *m_font, 8);
     m_flashText = std::make_shared<sf::Text>("", *m_font, 8);
+    m_outlineText = std::make_shared<sf::Text>("", *m_font, 8);
     m_text->setCharacterSize(characterSize);
     m_flashText->setCharacterSize(characterSize);
+    m_outlineText->setCharacterSize(characterSize);
 }
 
 void jt::Text::setText(std::string const& text)
 {
+    if (m_text->getString() == text) {
+        return;
+    }
     m_text->setString(text);
     m_flashText->setString(text);
+    m_outlineText->setString(text);
+    markContentChanged();
 }
 
 std::string jt::Text::getText() const { return m_text->getString(); }
@@ -49,6 +54,7 @@ void jt::Text::setScale(jt::Vector2f const& scale)
 {
     m_text->setScale(toLib(scale));
     m_flashText->setScale(toLib(scale));
+    m_outlineText->setScale(toLib(scale));
 }
 
 jt::Vector2f jt::Text::getScale() const { return fromLib(m_text->getScale()); }
@@ -58,10 +64,17 @@ void jt::Text::setOriginInternal(jt::Vector2f const& origin)
     if (m_text) {
         m_text->setOrigin(toLib(origin));
         m_flashText->setOrigin(toLib(origin));
+        m_outlineText->setOrigin(toLib(origin));
     }
 }
 
-void jt::Text::setTextAlign(jt::Text::TextAlign ta) { m_textAlign = ta; }
+void jt::Text::setTextAlign(jt::Text::TextAlign ta)
+{
+    if (m_textAlign != ta) {
+        m_textAlign = ta;
+        markContentChanged();
+    }
+}
 
 jt::Text::TextAlign jt::Text::getTextAlign() const { return m_textAlign; }
 
@@ -69,6 +82,7 @@ void jt::Text::doUpdate(float /*elapsed*/)
 {
     m_text->setFont(*m_font);
     m_flashText->setFont(*m_font);
+    m_outlineText->setFont(*m_font);
 
     jt::Vector2f alignOffset { 0, 0 };
     if (m_textAlign == TextAlign::CENTER) {
@@ -84,6 +98,8 @@ void jt::Text::doUpdate(float /*elapsed*/)
     m_text->setPosition(toLib(position));
     m_flashText->setPosition(toLib(position));
     m_flashText->setScale(m_text->getScale());
+    m_outlineText->setPosition(toLib(position));
+    m_outlineText->setScale(m_text->getScale());
 }
 
 void jt::Text::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -111,18 +127,14 @@ void jt::Text::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr)
         return;
     }
 
-    jt::Vector2f const oldPos = fromLib(m_text->getPosition());
-    jt::Color const oldCol = fromLib(m_text->getFillColor());
-
-    m_text->setFillColor(toLib(getOutlineColor()));
-
-    for (auto const outlineOffset : getOutlineOffsets()) {
-        m_text->setPosition(toLib(jt::MathHelper::castToInteger(oldPos + outlineOffset)));
-        sptr->draw(*m_text);
-    }
-
-    m_text->setPosition(toLib(oldPos));
-    m_text->setFillColor(toLib(oldCol));
+    // sf::Text builds the outline geometry once and only rebuilds it when the text, font or
+    // thickness changes, so the outline is drawn in one call. Setters return early when the value
+    // did not change.
+    auto const col = toLib(getOutlineColor());
+    m_outlineText->setFillColor(col);
+    m_outlineText->setOutlineColor(col);
+    m_outlineText->setOutlineThickness(static_cast<float>(getOutlineWidth()));
+    sptr->draw(*m_outlineText);
 }
 
 void jt::Text::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
@@ -148,4 +160,5 @@ void jt::Text::doRotate(float rot)
 {
     m_text->setRotation(rot);
     m_flashText->setRotation(rot);
+    m_outlineText->setRotation(rot);
 }
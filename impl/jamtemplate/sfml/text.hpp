@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_TEXT_HPP
 
 #include <SFML/Graphics.hpp>
+#include <cache/font_cache_interface.hpp>
 #include <drawable_impl_sfml.hpp>
 #include <render_target_layer.hpp>
 #include <memory>
@@ -22,8 +23,10 @@ public:
     /// \param fontFileName filename to the font (ttf)
     /// \param characterSize size in characters
     /// \param rendertarget_wptr the rendertarget (unused for sfml, but needed for sdl compatibility)
+    /// \param fontCache the font cache, texts with the same font and size share the font
     void loadFont(std::string const& fontFileName, unsigned int characterSize,
-        std::weak_ptr<jt::RenderTargetLayer> rendertarget_wptr /*unused*/);
+        std::weak_ptr<jt::RenderTargetLayer> rendertarget_wptr /*unused*/,
+        jt::FontCacheInterface& fontCache);
 
     /// set the text
     /// \param text the text to be displayed
@@ -59,6 +62,7 @@ public:
 private:
     mutable std::shared_ptr<sf::Text> m_text;
     std::shared_ptr<sf::Text> m_flashText;
+    std::shared_ptr<sf::Text> m_outlineText;
     std::shared_ptr<sf::Font> m_font;
 
     TextAlign m_textAlign { TextAlign::CENTER };
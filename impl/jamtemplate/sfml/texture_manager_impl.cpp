@@ -1,45 +1,37 @@
 #include "texture_manager_impl.hpp"
-#include <aselib/image_builder.hpp>
+#include <aseprite_cache.hpp>
+#include <asset_pack/virtual_file_system.hpp>
 #include <color_lib.hpp>
 #include <sprite_functions.hpp>
 #include <strutils.hpp>
 #include <tracy/Tracy.hpp>
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <iostream>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace {
 
-sf::Image createImageFromAse(std::string const& filename)
+// load an sf::Image or sf::Texture from the mounted asset packs, or from disk if it is not packed
+template <typename T>
+bool loadFromFileOrPack(T& target, std::string const& fileName)
 {
-    auto const asepritePos = filename.rfind(".aseprite");
-    auto const splittedFilename = filename.substr(0, asepritePos + 9);
-    auto const postFix = filename.substr(asepritePos + 9);
-    aselib::AsepriteData aseData { filename };
-
-    std::unique_ptr<aselib::Image> aseImage { nullptr };
-    if (strutil::contains(postFix, ".layer=")) {
-        auto const layerPos = postFix.find(".layer=");
-        auto const layerName = postFix.substr(layerPos + 7);
-        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
-    } else {
-        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
-        aseImage = std::make_unique<aselib::Image>(
-            aselib::makeImageFromAse(aseData, !ignore_transparent));
+    if (auto const data = jt::VirtualFileSystem::findInPack(fileName)) {
+        return target.loadFromMemory(data->data(), data->size());
     }
+    return target.loadFromFile(fileName);
+}
+
+sf::Image createImageFromAse(std::string const& filename)
+{
+    auto const decoded = jt::AsepriteCache::load(filename);
 
+    // decoded pixels are rgba values row by row, which is the layout sf::Image expects
     sf::Image sfImgage {};
-    jt::Color emptyColor { 0, 0, 0, 0 };
-    auto const w = aseImage->m_width;
-    auto const h = aseImage->m_height;
-    sfImgage.create(w, h, toLib(emptyColor));
-
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            auto const p = aseImage->m_pixels[aseImage->posToIndex(i, j)];
-            auto const col = jt::Color { p.r, p.g, p.b, p.a };
-            sfImgage.setPixel(i, j, toLib(col));
-        }
-    }
+    sfImgage.create(decoded.width, decoded.height, decoded.pixels.data());
     return sfImgage;
 }
 
@@ -120,6 +112,33 @@ sf::Image createRingImage(std::array<std::string, 2> const& ssv)
     return jt::SpriteFunctions::makeRing(ringImageSize);
 }
 
+sf::Image createStripImage(std::array<std::string, 7> const& ssv)
+{
+    if (ssv.at(1) != "h" && ssv.at(1) != "v") {
+        throw std::invalid_argument { "invalid strip orientation" };
+    }
+    std::size_t count { 0 };
+    auto const w = std::stol(ssv.at(5), &count);
+    if (count != ssv.at(5).size() || w <= 0) {
+        throw std::invalid_argument { "invalid strip w" };
+    }
+    auto const h = std::stol(ssv.at(6), &count);
+    if (count != ssv.at(6).size() || h <= 0) {
+        throw std::invalid_argument { "invalid strip h" };
+    }
+
+    std::array<sf::Image, 3> pieces {};
+    for (auto i = 0u; i != pieces.size(); ++i) {
+        auto const& fileName = ssv.at(i + 2);
+        if (!loadFromFileOrPack(pieces[i], fileName)) {
+            throw std::invalid_argument { "invalid filename, cannot load strip piece from '"
+                + fileName + "'" };
+        }
+    }
+    return jt::SpriteFunctions::makeStripImage(pieces[0], pieces[1], pieces[2],
+        static_cast<unsigned int>(w), static_cast<unsigned int>(h), ssv.at(1) == "h");
+}
+
 sf::Image createFlashImage(sf::Image const& in)
 {
     sf::Image img { in };
@@ -134,14 +153,100 @@ sf::Image createFlashImage(sf::Image const& in)
     return img;
 }
 
-sf::Texture loadTextureFromDisk(std::string const& str)
+std::shared_ptr<sf::Texture> loadTextureFromDisk(std::string const& str)
 {
-    sf::Texture t {};
-    if (!t.loadFromFile(str)) {
+    auto t = std::make_shared<sf::Texture>();
+    if (!loadFromFileOrPack(*t, str)) {
         throw std::invalid_argument { "invalid filename, cannot load texture from '" + str + "'" };
     }
     return t;
 }
+
+std::shared_ptr<sf::Texture> createTextureFromImage(sf::Image const& image)
+{
+    auto t = std::make_shared<sf::Texture>();
+    t->loadFromImage(image);
+    return t;
+}
+
+sf::Image createSpecialImage(std::string const& str)
+{
+    if (str.at(1) == 'b') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createButtonImage(ssv);
+    } else if (str.at(1) == 'f') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createBlankImage(ssv);
+    } else if (str.at(1) == 'g') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createGlowImage(ssv);
+    } else if (str.at(1) == 'v') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createVignetteImage(ssv);
+    } else if (str.at(1) == 'r') {
+        auto const ssv = strutil::split<2>(str.substr(1), '#');
+        return createRingImage(ssv);
+    } else if (str.at(1) == 's') {
+        auto const ssv = strutil::split<7>(str.substr(1), '#');
+        return createStripImage(ssv);
+    }
+    throw std::invalid_argument("ERROR: cannot get texture with name " + str);
+}
+
+// create the image on the cpu again, which is cheaper than reading back the texture from the gpu
+sf::Image createImage(std::string const& str)
+{
+    if (strutil::contains(str, ".aseprite")) {
+        return createImageFromAse(str);
+    }
+    if (str.starts_with('#')) {
+        return createSpecialImage(str);
+    }
+    sf::Image img {};
+    if (!loadFromFileOrPack(img, str)) {
+        throw std::invalid_argument { "invalid filename, cannot load image from '" + str + "'" };
+    }
+    return img;
+}
+
+std::shared_ptr<jt::IndexedImage const> createIndexedImage(std::string const& fileName)
+{
+    auto const image = createImage(fileName);
+    return std::make_shared<jt::IndexedImage const>(
+        image.getSize().x, image.getSize().y, image.getPixelsPtr());
+}
+
+std::shared_ptr<sf::Texture> createTextureFromIndexedImage(
+    jt::IndexedImage const& image, jt::Palette const& palette)
+{
+    auto t = std::make_shared<sf::Texture>();
+    if (!t->create(image.getWidth(), image.getHeight())) {
+        throw std::logic_error { "cannot create texture for indexed image" };
+    }
+    t->update(image.toRGBA(palette).data());
+    return t;
+}
+
+// the web build is not linked with pthreads, there the decoding is done by uploadPrefetched()
+#if JT_ENABLE_WEB
+constexpr auto decodeLaunchPolicy { std::launch::deferred };
+#else
+constexpr auto decodeLaunchPolicy { std::launch::async };
+#endif
+
+// prefetched textures are kept for about ten seconds at 60 fps while the budget is exceeded, after
+// that they are evicted like all other unused textures
+constexpr std::uint32_t prefetchGraceEvictions { 600u };
+
+constexpr std::string_view flashPostfix { "___flash__" };
+constexpr std::string_view palettePostfix { ".palette=" };
+
+bool isDecodedFromFile(std::string const& str)
+{
+    return !str.starts_with('#') && !str.ends_with(flashPostfix)
+        && !strutil::contains(str, palettePostfix);
+}
+
 } // namespace
 
 jt::TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> /*renderer*/)
@@ -149,7 +254,7 @@ jt::TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer
     // Nothing to do here
 }
 
-sf::Texture& jt::TextureManagerImpl::get(std::string const& str)
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::get(std::string const& str)
 {
     ZoneScopedNC("jt::TextureManagerImpl::get", tracy::Color::Crimson);
     if (str.empty()) {
@@ -157,62 +262,273 @@ sf::Texture& jt::TextureManagerImpl::get(std::string const& str)
     }
 
     // check if texture is already stored in texture manager
-    if (containsTexture(str)) {
+    jt::StringId const id { str };
+    if (auto const it = m_textures.find(id); it != m_textures.end()) {
         ZoneColor(tracy::Color::AntiqueWhite2);
-        return m_textures[str];
+        it->second.lastUse = ++m_useCounter;
+        it->second.prefetchGrace = 0u;
+        return it->second.texture;
+    }
+
+    // palette swaps do not change the silhouette, so all swaps share the flash image of the file
+    if (auto const pos = str.rfind(palettePostfix);
+        pos != std::string::npos && str.ends_with(flashPostfix)) {
+        return get(str.substr(0, pos) + std::string { flashPostfix });
+    }
+
+    return store(id, createTexture(str));
+}
+
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::createTexture(std::string const& str)
+{
+    // a prefetch of this texture is still running, so wait for it instead of decoding again
+    if (auto const pending = m_pendingDecodes.find(str); pending != m_pendingDecodes.end()) {
+        auto decode = std::move(pending->second);
+        m_pendingDecodes.erase(pending);
+        return createTextureFromImage(decode.get());
+    }
+
+    // flash images are only created when they are requested, which is usually the first time a
+    // drawable flashes, so textures that never flash are not kept in memory twice
+    if (str.ends_with(flashPostfix)) {
+        auto const baseName = str.substr(0, str.size() - flashPostfix.size());
+        return createTextureFromImage(createFlashImage(createImage(baseName)));
+    }
+
+    if (strutil::contains(str, palettePostfix)) {
+        return createPaletteTexture(str);
     }
 
     // Check if special ase parsing is required
     if (strutil::contains(str, ".aseprite")) {
-        m_textures[str].loadFromImage(createImageFromAse(str));
-        m_textures[getFlashName(str)].loadFromImage(
-            createFlashImage(m_textures[str].copyToImage()));
-        return m_textures[str];
+        return createTextureFromImage(createImageFromAse(str));
     }
 
     // normal filenames do not start with a '#'
     if (!str.starts_with('#')) {
-        m_textures[str] = loadTextureFromDisk(str);
-        m_textures[getFlashName(str)].loadFromImage(
-            createFlashImage(m_textures[str].copyToImage()));
-        return m_textures[str];
+        return loadTextureFromDisk(str);
     }
 
     // special type of images
-    if (str.at(1) == 'b') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createButtonImage(ssv));
-    } else if (str.at(1) == 'f') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createBlankImage(ssv));
-    } else if (str.at(1) == 'g') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createGlowImage(ssv));
-    } else if (str.at(1) == 'v') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createVignetteImage(ssv));
-    } else if (str.at(1) == 'r') {
-        auto const ssv = strutil::split<2>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createRingImage(ssv));
-    } else {
-        throw std::invalid_argument("ERROR: cannot get texture with name " + str);
+    return createTextureFromImage(createSpecialImage(str));
+}
+
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::store(
+    jt::StringId id, std::shared_ptr<sf::Texture> const& texture)
+{
+    auto const size = texture->getSize();
+    // sf::Texture always uses 32 bit rgba pixels
+    auto const bytes = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * 4u;
+    m_textures[id] = TextureEntry { texture, bytes, ++m_useCounter };
+    m_memoryUsage += bytes;
+    return texture;
+}
+
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::createPaletteTexture(std::string const& str)
+{
+    auto const pos = str.rfind(palettePostfix);
+    jt::StringId const swapId { std::string_view { str }.substr(pos + palettePostfix.size()) };
+    auto const swap = m_paletteSwaps.find(swapId);
+    if (swap == m_paletteSwaps.cend()) {
+        throw std::invalid_argument { "palette swap for '" + str + "' is not set" };
+    }
+
+    auto const image = getIndexedImage(str.substr(0, pos));
+    auto const texture = createTextureFromIndexedImage(
+        *image, image->getPalette().swapped(swap->second.source, swap->second.target));
+    m_paletteTextures[str] = PaletteTexture { image, swapId, texture };
+    return texture;
+}
+
+std::shared_ptr<jt::IndexedImage const> jt::TextureManagerImpl::getIndexedImage(
+    std::string const& fileName)
+{
+    auto& entry = m_indexedImages[fileName];
+    if (auto image = entry.lock()) {
+        return image;
+    }
+    auto image = createIndexedImage(fileName);
+    entry = image;
+    return image;
+}
+
+void jt::TextureManagerImpl::setPaletteSwap(
+    std::string const& name, jt::Palette const& source, jt::Palette const& target)
+{
+    ZoneScopedN("jt::TextureManagerImpl::setPaletteSwap");
+    if (source.size() != target.size()) {
+        throw std::invalid_argument { "source and target palette need to have the same size" };
+    }
+    jt::StringId const swapId { name };
+    m_paletteSwaps[swapId] = PaletteSwap { source, target };
+
+    // the indices are kept, so existing textures are updated without decoding the files again
+    removeUnusedPaletteTextures();
+    for (auto const& kvp : m_paletteTextures) {
+        if (kvp.second.swap != swapId) {
+            continue;
+        }
+        auto const texture = kvp.second.texture.lock();
+        auto const& image = *kvp.second.image;
+        texture->update(image.toRGBA(image.getPalette().swapped(source, target)).data());
+    }
+}
+
+void jt::TextureManagerImpl::removeUnusedPaletteTextures()
+{
+    std::erase_if(m_paletteTextures, [](auto const& kvp) { return kvp.second.texture.expired(); });
+    std::erase_if(m_indexedImages, [](auto const& kvp) { return kvp.second.expired(); });
+}
+
+void jt::TextureManagerImpl::prefetch(std::string const& str)
+{
+    if (str.empty()) {
+        throw std::invalid_argument { "TextureManager prefetch: string must not be empty" };
+    }
+    if (!isDecodedFromFile(str) || containsTexture(str) || m_pendingDecodes.contains(str)
+        || m_failedDecodes.contains(str)) {
+        return;
+    }
+    // sf::Image only lives in ram, so it can be created on a worker thread
+    m_pendingDecodes[str] = std::async(decodeLaunchPolicy, [str]() { return createImage(str); });
+}
+
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::getAsync(std::string const& str)
+{
+    if (containsTexture(str) || !isDecodedFromFile(str) || m_failedDecodes.contains(str)) {
+        return get(str);
     }
+    prefetch(str);
 
-    // create Flash Image
-    m_textures[getFlashName(str)].loadFromImage(createFlashImage(m_textures[str].copyToImage()));
+    if (!m_placeholder) [[unlikely]] {
+        sf::Image image {};
+        image.create(1u, 1u, sf::Color::Transparent);
+        m_placeholder = createTextureFromImage(image);
+    }
+    return m_placeholder;
+}
+
+bool jt::TextureManagerImpl::isLoaded(std::string const& str) const { return containsTexture(str); }
+
+void jt::TextureManagerImpl::uploadPrefetched(float timeBudget)
+{
+    ZoneScopedN("jt::TextureManagerImpl::uploadPrefetched");
+    if (m_pendingDecodes.empty()) {
+        return;
+    }
 
-    return m_textures[str];
+    auto const start = std::chrono::steady_clock::now();
+    for (auto it = m_pendingDecodes.begin(); it != m_pendingDecodes.end();) {
+        // deferred decodes are run here, on the main thread
+        if (it->second.wait_for(std::chrono::seconds { 0 }) == std::future_status::timeout) {
+            ++it;
+            continue;
+        }
+        auto const id = it->first;
+        auto decode = std::move(it->second);
+        it = m_pendingDecodes.erase(it);
+        try {
+            store(id, createTextureFromImage(decode.get()));
+            m_textures[id].prefetchGrace = prefetchGraceEvictions;
+        } catch (std::exception const& e) {
+            // a failed prefetch must not stop the game, get() reports the error to the caller
+            std::cout << "Warning: prefetching texture failed: " << e.what() << std::endl;
+            m_failedDecodes.insert(id);
+        }
+
+        std::chrono::duration<float> const elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= timeBudget) {
+            return;
+        }
+    }
 }
 
-void jt::TextureManagerImpl::reset() { m_textures.clear(); }
+void jt::TextureManagerImpl::reset()
+{
+    // waits for running decodes
+    m_pendingDecodes.clear();
+    m_failedDecodes.clear();
+    m_textures.clear();
+    m_paletteTextures.clear();
+    m_indexedImages.clear();
+    m_memoryUsage = 0u;
+}
 
 std::string jt::TextureManagerImpl::getFlashName(std::string const& str)
 {
-    return str + "___flash__";
+    return str + std::string { flashPostfix };
+}
+
+std::shared_ptr<sf::Texture> jt::TextureManagerImpl::getOutline(
+    std::string const& str, jt::Recti const& rect, int width)
+{
+    if (width <= 0) {
+        throw std::invalid_argument { "outline width must be positive" };
+    }
+    auto const outlineName = str + "___outline__" + std::to_string(rect.left) + "#"
+        + std::to_string(rect.top) + "#" + std::to_string(rect.width) + "#"
+        + std::to_string(rect.height) + "#" + std::to_string(width);
+    if (auto const it = m_textures.find(outlineName); it != m_textures.end()) {
+        it->second.lastUse = ++m_useCounter;
+        return it->second.texture;
+    }
+
+    // files and special images are created on the cpu again, only flash and palette textures have
+    // no cpu source and are read back from the gpu
+    auto const image = str.ends_with(flashPostfix) || strutil::contains(str, palettePostfix)
+        ? get(str)->copyToImage()
+        : createImage(str);
+    return store(outlineName,
+        createTextureFromImage(jt::SpriteFunctions::makeOutlineImage(image, toLib(rect), width)));
 }
 
 std::size_t jt::TextureManagerImpl::getNumberOfTextures() noexcept { return m_textures.size(); }
 
+std::size_t jt::TextureManagerImpl::getMemoryUsage() const noexcept { return m_memoryUsage; }
+
+std::size_t jt::TextureManagerImpl::getMemoryUsage(std::string const& str) const
+{
+    auto const it = m_textures.find(str);
+    return it == m_textures.cend() ? 0u : it->second.bytes;
+}
+
+void jt::TextureManagerImpl::setMemoryBudget(std::size_t bytes) noexcept
+{
+    m_memoryBudget = bytes;
+}
+
+void jt::TextureManagerImpl::evictUnused()
+{
+    if (m_memoryBudget == 0u || m_memoryUsage <= m_memoryBudget) [[likely]] {
+        return;
+    }
+    ZoneScopedN("jt::TextureManagerImpl::evictUnused");
+
+    // textures only referenced by the texture manager are not used by any drawable
+    std::vector<decltype(m_textures)::iterator> unused {};
+    for (auto it = m_textures.begin(); it != m_textures.end(); ++it) {
+        if (it->second.texture.use_count() != 1) {
+            continue;
+        }
+        if (it->second.prefetchGrace != 0u) {
+            --it->second.prefetchGrace;
+            continue;
+        }
+        unused.push_back(it);
+    }
+    std::sort(unused.begin(), unused.end(),
+        [](auto const& a, auto const& b) { return a->second.lastUse < b->second.lastUse; });
+
+    for (auto const& it : unused) {
+        if (m_memoryUsage <= m_memoryBudget) {
+            break;
+        }
+        m_memoryUsage -= it->second.bytes;
+        m_textures.erase(it);
+    }
+    removeUnusedPaletteTextures();
+}
+
 bool jt::TextureManagerImpl::containsTexture(std::string const& str) const
 {
     return (m_textures.contains(str));
@@ -1,23 +1,87 @@
 #ifndef JAMTEMPLATE_TEXTURE_MANAGER_IMPL_HPP
 #define JAMTEMPLATE_TEXTURE_MANAGER_IMPL_HPP
 
+#include <color/indexed_image.hpp>
 #include <SFML/Graphics.hpp>
+#include <string_id.hpp>
 #include <texture_manager_interface.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <map>
 #include <memory>
+#include <set>
 
 namespace jt {
 class TextureManagerImpl : public ::jt::TextureManagerInterface {
 public:
     explicit TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer);
-    sf::Texture& get(std::string const& str) override;
+    std::shared_ptr<sf::Texture> get(std::string const& str) override;
+    void prefetch(std::string const& str) override;
+    std::shared_ptr<sf::Texture> getAsync(std::string const& str) override;
+    bool isLoaded(std::string const& str) const override;
+    void uploadPrefetched(float timeBudget) override;
     void reset() override;
     std::string getFlashName(std::string const& str) override;
+    std::shared_ptr<sf::Texture> getOutline(
+        std::string const& str, jt::Recti const& rect, int width) override;
     std::size_t getNumberOfTextures() noexcept override;
 
+    std::size_t getMemoryUsage() const noexcept override;
+    std::size_t getMemoryUsage(std::string const& str) const override;
+    void setMemoryBudget(std::size_t bytes) noexcept override;
+    void evictUnused() override;
+
+    void setPaletteSwap(
+        std::string const& name, jt::Palette const& source, jt::Palette const& target) override;
+
 private:
-    std::map<std::string, sf::Texture> m_textures;
+    struct TextureEntry {
+        std::shared_ptr<sf::Texture> texture { nullptr };
+        std::size_t bytes { 0u };
+        // value of m_useCounter when the texture was requested the last time
+        std::uint64_t lastUse { 0u };
+        // prefetched but not requested yet: number of over budget evictUnused() calls the texture
+        // survives, so preloaded textures are not evicted before the first get()
+        std::uint32_t prefetchGrace { 0u };
+    };
+
+    std::map<jt::StringId, TextureEntry> m_textures;
+    // images decoded on worker threads, uploaded as textures on the main thread
+    std::map<jt::StringId, std::future<sf::Image>> m_pendingDecodes;
+    // prefetches which could not be decoded, get() loads them again to report the error
+    std::set<jt::StringId> m_failedDecodes;
+    std::shared_ptr<sf::Texture> m_placeholder { nullptr };
+
+    struct PaletteSwap {
+        jt::Palette source {};
+        jt::Palette target {};
+    };
+
+    struct PaletteTexture {
+        std::shared_ptr<jt::IndexedImage const> image { nullptr };
+        jt::StringId swap {};
+        // textures are owned by m_textures and the drawables using them
+        std::weak_ptr<sf::Texture> texture {};
+    };
+
+    std::map<jt::StringId, PaletteSwap> m_paletteSwaps;
+    // images are shared by all palette swapped textures of the same file
+    std::map<jt::StringId, std::weak_ptr<jt::IndexedImage const>> m_indexedImages;
+    std::map<jt::StringId, PaletteTexture> m_paletteTextures;
+
+    std::uint64_t m_useCounter { 0u };
+    std::size_t m_memoryUsage { 0u };
+    // 0 means unlimited
+    std::size_t m_memoryBudget { 0u };
+
     bool containsTexture(std::string const& str) const;
+    std::shared_ptr<sf::Texture> createTexture(std::string const& str);
+    std::shared_ptr<sf::Texture> store(
+        jt::StringId id, std::shared_ptr<sf::Texture> const& texture);
+    std::shared_ptr<sf::Texture> createPaletteTexture(std::string const& str);
+    std::shared_ptr<jt::IndexedImage const> getIndexedImage(std::string const& fileName);
+    void removeUnusedPaletteTextures();
 };
 } // namespace jt
 
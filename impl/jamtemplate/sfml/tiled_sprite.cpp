@@ -0,0 +1,173 @@
+#include "tiled_sprite.hpp"
+#include <color_lib.hpp>
+#include <math_helper.hpp>
+#include <vector_lib.hpp>
+#include <cmath>
+
+namespace {
+
+int wrapToTexture(float value, unsigned int textureSize)
+{
+    auto const size = static_cast<int>(textureSize);
+    auto const wrapped = static_cast<int>(std::floor(value)) % size;
+    return wrapped < 0 ? wrapped + size : wrapped;
+}
+
+} // namespace
+
+jt::TiledSprite::TiledSprite(std::string const& fileName, jt::Vector2f const& size,
+    jt::TextureManagerInterface& textureManager)
+    : m_fileName { fileName }
+    , m_textureManager { &textureManager }
+    , m_size { size }
+{
+    m_texture = textureManager.get(fileName);
+    // repeating only affects texture coordinates outside of the texture, so this does not change
+    // how other sprites using the same texture are drawn.
+    m_texture->setRepeated(true);
+    m_sprite.setTexture(*m_texture);
+    updateTextureRect();
+}
+
+void jt::TiledSprite::setPosition(jt::Vector2f const& pos)
+{
+    m_position = pos;
+    markTransformDirty();
+}
+
+jt::Vector2f jt::TiledSprite::getPosition() const { return m_position; }
+
+void jt::TiledSprite::setColor(jt::Color const& col) { m_sprite.setColor(toLib(col)); }
+
+jt::Color jt::TiledSprite::getColor() const { return fromLib(m_sprite.getColor()); }
+
+jt::Rectf jt::TiledSprite::getGlobalBounds() const
+{
+    // screen position like Sprite, which includes offset, shake and camera
+    refreshTransform();
+    auto const screenPosition = fromLib(m_sprite.getPosition());
+    return jt::Rectf { screenPosition.x, screenPosition.y, m_size.x, m_size.y };
+}
+
+jt::Rectf jt::TiledSprite::getLocalBounds() const
+{
+    return jt::Rectf { 0.0f, 0.0f, m_size.x, m_size.y };
+}
+
+void jt::TiledSprite::setScale(jt::Vector2f const& scale)
+{
+    m_sprite.setScale(scale.x, scale.y);
+    m_flashSprite.setScale(scale.x, scale.y);
+    updateTextureRect();
+}
+
+jt::Vector2f jt::TiledSprite::getScale() const { return fromLib(m_sprite.getScale()); }
+
+void jt::TiledSprite::setSize(jt::Vector2f const& size)
+{
+    m_size = size;
+    updateTextureRect();
+}
+
+jt::Vector2f jt::TiledSprite::getSize() const { return m_size; }
+
+void jt::TiledSprite::setScrollOffset(jt::Vector2f const& offset)
+{
+    m_scrollOffset = offset;
+    updateTextureRect();
+}
+
+jt::Vector2f jt::TiledSprite::getScrollOffset() const { return m_scrollOffset; }
+
+jt::Vector2f jt::TiledSprite::getTextureSize() const
+{
+    auto const texture = m_sprite.getTexture();
+    if (!texture) [[unlikely]] {
+        return jt::Vector2f { 0.0f, 0.0f };
+    }
+    return fromLib(sf::Vector2f { texture->getSize() });
+}
+
+void jt::TiledSprite::updateTextureRect()
+{
+    auto const texture = m_sprite.getTexture();
+    auto const scale = m_sprite.getScale();
+    if (!texture || texture->getSize().x == 0 || texture->getSize().y == 0 || scale.x == 0.0f
+        || scale.y == 0.0f) [[unlikely]] {
+        return;
+    }
+    // the scroll offset is wrapped, so the texture coordinates stay small and precise
+    sf::IntRect const rect { wrapToTexture(m_scrollOffset.x, texture->getSize().x),
+        wrapToTexture(m_scrollOffset.y, texture->getSize().y),
+        static_cast<int>(std::ceil(m_size.x / std::fabs(scale.x))),
+        static_cast<int>(std::ceil(m_size.y / std::fabs(scale.y))) };
+    m_sprite.setTextureRect(rect);
+    m_flashSprite.setTextureRect(rect);
+}
+
+void jt::TiledSprite::doUpdate(float /*elapsed*/) { }
+
+void jt::TiledSprite::doRefreshTransform() const
+{
+    auto const screenPosition = toLib(jt::MathHelper::castToInteger(
+        m_position + getShakeOffset() + getOffset() + getCompleteCamOffset()));
+    m_sprite.setPosition(screenPosition);
+    m_flashSprite.setPosition(screenPosition);
+}
+
+void jt::TiledSprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    jt::RenderCommand command { sptr.get(), m_sprite, sf::BlendAlpha, m_texture };
+    command.sprite.move(toLib(getShadowOffset()));
+    command.sprite.setColor(toLib(getShadowColor()));
+    submit(command);
+}
+
+void jt::TiledSprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    jt::RenderCommand command { sptr.get(), m_sprite, sf::BlendAlpha, m_texture };
+    command.sprite.setColor(toLib(getOutlineColor()));
+    for (auto const& outlineOffset : getOutlineOffsets()) {
+        command.sprite.setPosition(m_sprite.getPosition() + toLib(outlineOffset));
+        submit(command);
+    }
+}
+
+void jt::TiledSprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    submit(jt::RenderCommand { sptr.get(), m_sprite, getSfBlendMode(), m_texture });
+}
+
+void jt::TiledSprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    if (!m_flashSprite.getTexture()) {
+        m_flashTexture = m_textureManager->get(m_textureManager->getFlashName(m_fileName));
+        m_flashTexture->setRepeated(true);
+        m_flashSprite.setTexture(*m_flashTexture);
+        m_flashSprite.setTextureRect(m_sprite.getTextureRect());
+    }
+    m_flashSprite.setColor(toLib(getFlashColor()));
+    // flash is drawn immediately, so it always ends up above the sprite, even in sorted ZLayers
+    submit(
+        jt::RenderCommand { sptr.get(), m_flashSprite, sf::BlendAlpha, m_flashTexture }, false);
+}
+
+void jt::TiledSprite::doRotate(float /*rot*/) { }
+
+bool jt::TiledSprite::usesRenderQueue() const { return true; }
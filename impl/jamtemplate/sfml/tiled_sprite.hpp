@@ -0,0 +1,95 @@
+#ifndef JAMTEMPLATE_TILED_SPRITE_HPP
+#define JAMTEMPLATE_TILED_SPRITE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <color/color.hpp>
+#include <drawable_impl_sfml.hpp>
+#include <render_target_layer.hpp>
+#include <texture_manager_interface.hpp>
+#include <vector.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+
+/// Drawable that fills a rectangular region with a repeating texture in one draw call, e.g. for
+/// parallax backgrounds. Rotation is not supported.
+class TiledSprite : public DrawableImplSFML {
+public:
+    using Sptr = std::shared_ptr<TiledSprite>;
+
+    /// Constructor
+    /// \param fileName texture to repeat
+    /// \param size size of the region in pixel
+    /// \param textureManager texture manager
+    TiledSprite(std::string const& fileName, jt::Vector2f const& size,
+        jt::TextureManagerInterface& textureManager);
+
+    void setPosition(jt::Vector2f const& pos) override;
+    jt::Vector2f getPosition() const override;
+
+    void setColor(jt::Color const& col) override;
+    jt::Color getColor() const override;
+
+    jt::Rectf getGlobalBounds() const override;
+    jt::Rectf getLocalBounds() const override;
+
+    /// Set the scale of the texture. The size of the region is not affected.
+    /// \param scale the scale
+    void setScale(jt::Vector2f const& scale) override;
+    jt::Vector2f getScale() const override;
+
+    /// Set the size of the region
+    /// \param size size in pixel
+    void setSize(jt::Vector2f const& size);
+
+    /// Get the size of the region
+    /// \return size in pixel
+    jt::Vector2f getSize() const;
+
+    /// Set the scroll offset, i.e. the texture coordinate shown in the top left corner of the
+    /// region. Values outside of the texture size wrap around.
+    /// \param offset the offset in texture pixel
+    void setScrollOffset(jt::Vector2f const& offset);
+
+    /// Get the scroll offset
+    /// \return offset in texture pixel
+    jt::Vector2f getScrollOffset() const;
+
+    /// Get the size of the repeated texture
+    /// \return size in texture pixel
+    jt::Vector2f getTextureSize() const;
+
+private:
+    // textures are shared with the texture manager, so they are not evicted while in use
+    std::shared_ptr<sf::Texture> m_texture { nullptr };
+    mutable std::shared_ptr<sf::Texture> m_flashTexture { nullptr };
+
+    mutable sf::Sprite m_sprite;
+
+    // flash texture is requested from the texture manager when it is drawn first
+    std::string m_fileName { "" };
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    mutable sf::Sprite m_flashSprite;
+
+    jt::Vector2f m_position { 0.0f, 0.0f };
+    jt::Vector2f m_size { 0.0f, 0.0f };
+    jt::Vector2f m_scrollOffset { 0.0f, 0.0f };
+
+    void doUpdate(float /*elapsed*/) override;
+    void doRefreshTransform() const override;
+
+    void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doRotate(float /*rot*/) override;
+
+    bool usesRenderQueue() const override;
+
+    void updateTextureRect();
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_TILED_SPRITE_HPP
@@ -0,0 +1,83 @@
+#include "asset_pack_writer.hpp"
+#include <asset_pack/asset_pack_format.hpp>
+#include <string_id.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+struct PackedFile {
+    std::string path {};
+    jt::AssetPack::IndexEntry entry {};
+};
+
+std::vector<PackedFile> collectFiles(std::vector<std::string> const& folders)
+{
+    std::vector<PackedFile> files {};
+    for (auto const& folder : folders) {
+        if (!std::filesystem::is_directory(folder)) {
+            throw std::invalid_argument { "'" + folder + "' is not a directory" };
+        }
+        for (auto const& dirEntry : std::filesystem::recursive_directory_iterator { folder }) {
+            if (!dirEntry.is_regular_file()) {
+                continue;
+            }
+            auto path = jt::AssetPack::normalizePath(dirEntry.path().generic_string());
+            auto const hash = jt::StringId { path }.getHash();
+            files.push_back(PackedFile { std::move(path),
+                jt::AssetPack::IndexEntry { hash, 0u, dirEntry.file_size() } });
+        }
+    }
+
+    std::sort(files.begin(), files.end(),
+        [](auto const& a, auto const& b) { return a.entry.hash < b.entry.hash; });
+    auto const duplicate = std::adjacent_find(files.cbegin(), files.cend(),
+        [](auto const& a, auto const& b) { return a.entry.hash == b.entry.hash; });
+    if (duplicate != files.cend()) {
+        throw std::logic_error { "hash collision or duplicate file in asset pack: '"
+            + duplicate->path + "' and '" + std::next(duplicate)->path + "'" };
+    }
+    return files;
+}
+
+} // namespace
+
+std::size_t jt::AssetPack::writePack(
+    std::string const& packFileName, std::vector<std::string> const& folders)
+{
+    auto files = collectFiles(folders);
+
+    std::uint64_t offset = sizeof(Header) + files.size() * sizeof(IndexEntry);
+    for (auto& file : files) {
+        file.entry.offset = offset;
+        offset += file.entry.size;
+    }
+
+    std::ofstream out { packFileName, std::ios::binary };
+    if (!out) {
+        throw std::invalid_argument { "cannot open asset pack '" + packFileName + "'" };
+    }
+    Header const header = convertLittleEndian(Header { magic, version, files.size() });
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    for (auto const& file : files) {
+        auto const entry = convertLittleEndian(file.entry);
+        out.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+    }
+    for (auto const& file : files) {
+        std::ifstream in { file.path, std::ios::binary };
+        if (!in) [[unlikely]] {
+            throw std::invalid_argument { "cannot open '" + file.path + "'" };
+        }
+        // streaming an empty file would set the failbit of the output
+        if (file.entry.size != 0u) {
+            out << in.rdbuf();
+        }
+    }
+    if (!out || static_cast<std::uint64_t>(out.tellp()) != offset) [[unlikely]] {
+        throw std::logic_error { "could not write asset pack '" + packFileName + "'" };
+    }
+    return files.size();
+}
@@ -0,0 +1,22 @@
+#ifndef JAMTEMPLATE_ASSET_PACK_WRITER_HPP
+#define JAMTEMPLATE_ASSET_PACK_WRITER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace jt {
+namespace AssetPack {
+
+/// Write all files in the given folders and their subfolders into a single pack file. Files are
+/// stored with their path relative to the working directory, so the packer should be run from
+/// the directory which contains the asset folders, e.g. "assets".
+/// \param packFileName the pack file to write
+/// \param folders folders to pack, e.g. "assets"
+/// \return number of packed files
+std::size_t writePack(std::string const& packFileName, std::vector<std::string> const& folders);
+
+} // namespace AssetPack
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASSET_PACK_WRITER_HPP
@@ -0,0 +1,23 @@
+#include "asset_pack_writer.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <pack file> <folder> [folders...]\n";
+        return 1;
+    }
+
+    std::vector<std::string> const folders { argv + 2, argv + argc };
+    try {
+        auto const numberOfFiles = jt::AssetPack::writePack(argv[1], folders);
+        std::cout << "packed " << numberOfFiles << " files into '" << argv[1] << "'\n";
+    } catch (std::exception const& e) {
+        std::cerr << "could not create asset pack: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}